@@ -0,0 +1,165 @@
+#include "aho_corasick.h"
+#include "mint_utils.h"
+
+#include <algorithm>
+#include <cctype>
+
+AhoCorasick::AhoCorasick(const std::vector<std::string> &_patterns, const bool ignore_case)
+        : patterns(_patterns), class_num(1) {
+    for (const auto& pattern : patterns) {
+        if (pattern.empty()) {
+            throw mints::invalid_pattern("at AhoCorasick::AhoCorasick : an empty pattern matches everywhere");
+        }
+    }
+
+    // Give a class to every byte in some pattern; with ignore_case, a letter takes the class of its lowercase.
+    const auto fold = [ignore_case](unsigned char c) {
+        return ignore_case ? static_cast<unsigned char>(std::tolower(c)) : c;
+    };
+    for (const auto& pattern : patterns) {
+        for (char ch : pattern) {
+            const unsigned char c = fold(static_cast<unsigned char>(ch));
+            if (char_class[c] == 0) {
+                char_class[c] = static_cast<uint16_t>(class_num++);
+            }
+        }
+    }
+    if (ignore_case) {
+        for (int c = 'A'; c <= 'Z'; ++c) {
+            char_class[c] = char_class[std::tolower(c)];
+        }
+    }
+
+    // The trie of the patterns : a missing edge is 0, since no edge leads back to the start.
+    delta.assign(class_num, 0);
+    pattern_at.assign(1, NONE);
+    for (uint32_t id = 0; id < patterns.size(); ++id) {
+        uint32_t state = 0;
+        for (char ch : patterns[id]) {
+            uint32_t& next = delta[state * class_num + char_class[static_cast<unsigned char>(ch)]];
+            if (next == 0) {
+                next = static_cast<uint32_t>(pattern_at.size());
+                pattern_at.push_back(NONE);
+                delta.resize(delta.size() + class_num, 0);
+            }
+            // 'next' may dangle after the resize, so read the table again.
+            state = delta[state * class_num + char_class[static_cast<unsigned char>(ch)]];
+        }
+        if (pattern_at[state] == NONE) {
+            pattern_at[state] = id;
+        }
+    }
+
+    /*
+     Breadth-first, so the failure link of a state, which is shallower, is complete before the state is seen.
+     A missing edge of s by the class c becomes the edge of its failure link by c; an edge to t sets the failure link
+     of t to where the failure link of s goes by c.
+     */
+    const auto state_num = static_cast<uint32_t>(pattern_at.size());
+    std::vector<uint32_t> fail(state_num, 0);
+    first_output.assign(state_num, NONE);
+    output_link.assign(state_num, NONE);
+
+    std::vector<uint32_t> queue;
+    queue.reserve(state_num);
+    for (uint32_t c = 0; c < class_num; ++c) {
+        if (delta[c] != 0) {
+            queue.push_back(delta[c]);
+        }
+    }
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const uint32_t state = queue[head];
+        output_link[state] = first_output[fail[state]];
+        first_output[state] = pattern_at[state] != NONE ? state : output_link[state];
+
+        for (uint32_t c = 0; c < class_num; ++c) {
+            uint32_t& next = delta[state * class_num + c];
+            const uint32_t by_fail = delta[fail[state] * class_num + c];
+            if (next == 0) {
+                next = by_fail;
+            } else {
+                fail[next] = by_fail;
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+std::vector<AhoCorasick::Match> AhoCorasick::find_all(std::string_view text) const {
+    std::vector<Match> matches;
+    for_each_match(text, [&matches](const Match& match) {
+        matches.push_back(match);
+    });
+    return matches;
+}
+
+std::vector<AhoCorasick::Match> AhoCorasick::find_leftmost_longest(std::string_view text) const {
+    std::vector<Match> matches = find_all(text);
+    std::sort(matches.begin(), matches.end(), [this](const Match& a, const Match& b) {
+        if (a.pos != b.pos) {
+            return a.pos < b.pos;
+        }
+        return patterns[a.pattern].size() > patterns[b.pattern].size();
+    });
+
+    std::vector<Match> chosen;
+    std::size_t end = 0;
+    for (const auto& match : matches) {
+        if (match.pos >= end) {
+            chosen.push_back(match);
+            end = match.pos + patterns[match.pattern].size();
+        }
+    }
+    return chosen;
+}
+
+std::string AhoCorasick::replace_all(std::string_view text, const std::vector<std::string> &replacements) const {
+    return replace_matches(text, find_leftmost_longest(text), replacements);
+}
+
+std::string AhoCorasick::replace_matches(std::string_view text, const std::vector<Match> &matches,
+                                         const std::vector<std::string> &replacements) const {
+    if (replacements.size() != patterns.size()) {
+        throw mints::input_out_of_range("at AhoCorasick::replace_all : {patterns : " + std::to_string(patterns.size())
+                                        + ", replacements : " + std::to_string(replacements.size()) + "}");
+    }
+
+    std::size_t length = text.size();
+    for (const auto& match : matches) {
+        length = length - patterns[match.pattern].size() + replacements[match.pattern].size();
+    }
+
+    std::string ret;
+    ret.reserve(length);
+    std::size_t copied = 0;
+    for (const auto& match : matches) {
+        ret.append(text, copied, match.pos - copied);
+        ret += replacements[match.pattern];
+        copied = match.pos + patterns[match.pattern].size();
+    }
+    ret.append(text, copied);
+    return ret;
+}
+
+const std::string &AhoCorasick::get_pattern(const uint32_t id) const {
+    return patterns.at(id);
+}
+
+std::size_t AhoCorasick::pattern_num() const {
+    return patterns.size();
+}
+
+std::size_t AhoCorasick::state_num() const {
+    return pattern_at.size();
+}
+
+std::size_t AhoCorasick::memory_usage() const {
+    std::size_t bytes = sizeof(AhoCorasick);
+    for (const auto& pattern : patterns) {
+        bytes += pattern.capacity();
+    }
+    bytes += patterns.capacity() * sizeof(std::string);
+    bytes += delta.capacity() * sizeof(uint32_t);
+    bytes += (pattern_at.capacity() + first_output.capacity() + output_link.capacity()) * sizeof(uint32_t);
+    return bytes;
+}
@@ -0,0 +1,97 @@
+#ifndef OOPFINAL_AHO_CORASICK_H
+#define OOPFINAL_AHO_CORASICK_H
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+class AhoCorasick {
+    /*
+     "AhoCorasick" finds every occurrence of a whole set of patterns in a text in one pass over the text,
+     instead of one pass per pattern : the time is the length of the text plus the number of matches,
+     however many patterns there are.
+
+     The patterns are put into a trie first. Then every state gets a failure link : the state of the longest
+     proper suffix of its path which is also a path of the trie. i.e. for {"he", "she", "hers"}, the failure link of
+     "sh" is "h", and that of "she" is "he". When the next letter of the text has no edge, the scan goes on from
+     the failure link instead of starting over, so no letter is read twice.
+     Every state also gets an output link : the nearest state on its failure chain where a pattern ends.
+     Reading "she" ends "she", and its output link tells that "he" ends there as well.
+
+     The failure links are folded into a full transition table, so the scan does one lookup per byte with no
+     failure chain to follow : delta[state * class_num + class of the byte].
+     The patterns are not limited to 'a' to 'z' like a Trie; any byte may be in them. To keep the table small,
+     the bytes are mapped to dense classes first : class 0 for every byte in no pattern, which always leads back to
+     the start, and one class for each byte in some pattern. With 'ignore_case', an uppercase and a lowercase letter
+     share one class, so the text needs no lowercase copy.
+     A state is 4 bytes per class, so some hundreds of English terms take some hundred kilobytes.
+     */
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    std::vector<std::string>    patterns;
+    std::array<uint16_t, 256>   char_class{};
+    uint32_t                    class_num;
+
+    std::vector<uint32_t>       delta;
+    // pattern_at[s] is the pattern ending exactly at the state s, or NONE.
+    std::vector<uint32_t>       pattern_at;
+    // first_output[s] is the nearest state from s along its failure chain (s itself first) where a pattern ends;
+    // output_link[s] is the same but starting from the failure link of s. NONE if there is no such state.
+    std::vector<uint32_t>       first_output;
+    std::vector<uint32_t>       output_link;
+
+public:
+    struct Match {
+        // The byte where the occurrence starts, and the index of the pattern in the vector given to the constructor
+        std::size_t pos;
+        uint32_t    pattern;
+
+        bool operator==(const Match& other) const = default;
+    };
+
+    /*
+     Throws mints::invalid_pattern if a pattern is empty.
+     If a pattern is given twice, its occurrences are reported with the index of the first one.
+     */
+    explicit AhoCorasick(const std::vector<std::string>& _patterns, bool ignore_case = false);
+
+    // Call f(match) for every occurrence of every pattern, overlapping ones included,
+    // in the order of their last byte; the longer pattern first if two end at the same byte.
+    template<typename F>
+    void for_each_match(std::string_view text, F&& f) const {
+        uint32_t state = 0;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            state = delta[state * class_num + char_class[static_cast<unsigned char>(text[i])]];
+            for (uint32_t out = first_output[state]; out != NONE; out = output_link[out]) {
+                const uint32_t id = pattern_at[out];
+                f(Match{i + 1 - patterns[id].size(), id});
+            }
+        }
+    }
+
+    // Every occurrence, in the order of for_each_match
+    [[nodiscard]] std::vector<Match> find_all(std::string_view text) const;
+
+    /*
+     The occurrences that replace_all changes : scanning from the left, the longest one starting at the leftmost place,
+     then the same again after its end. i.e. for {"he", "hers", "she"} in "ushers", only "she" at 1.
+     Sorted by position.
+     */
+    [[nodiscard]] std::vector<Match> find_leftmost_longest(std::string_view text) const;
+
+    // The text with every occurrence of find_leftmost_longest replaced with replacements[pattern], built in one go.
+    // Throws mints::input_out_of_range if there is not one replacement per pattern.
+    [[nodiscard]] std::string replace_all(std::string_view text, const std::vector<std::string>& replacements) const;
+    // Same, with the occurrences already found by find_leftmost_longest(text)
+    [[nodiscard]] std::string replace_matches(std::string_view text, const std::vector<Match>& matches,
+                                              const std::vector<std::string>& replacements) const;
+
+    [[nodiscard]] const std::string& get_pattern(uint32_t id) const;
+    [[nodiscard]] std::size_t pattern_num() const;
+    [[nodiscard]] std::size_t state_num() const;
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+#endif //OOPFINAL_AHO_CORASICK_H
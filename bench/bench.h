@@ -0,0 +1,125 @@
+#ifndef OOPFINAL_BENCH_BENCH_H
+#define OOPFINAL_BENCH_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mint_utils.h"
+
+/*
+ What the benchmarks share : the word lists and a clock. A benchmark reads dict.txt, or the word list given as its
+ first argument, one word per line as main reads it. The times are the best of some runs, in nanoseconds per operation
+ or milliseconds per run, so a noisy machine shows up as a range over launches rather than as a wrong mean.
+ */
+namespace bench {
+
+    using Clock = std::chrono::steady_clock;
+
+    // The words of the list, lowercased, in the order of the file
+    inline std::vector<std::string> words(int argc, char** argv) {
+        const std::string path = argc > 1 ? argv[1] : MINTS_DICT_PATH;
+        std::ifstream ifile(path);
+        if (not ifile) {
+            throw mints::unable_to_open_file("Unable to open file : {name : " + path + "}");
+        }
+        std::vector<std::string> ret;
+        std::string line, word;
+        while (getline(ifile, line)) {
+            word.clear();
+            std::istringstream(mints::make_lowercase(line)) >> word;
+            if (!word.empty()) {
+                ret.push_back(word);
+            }
+        }
+        return ret;
+    }
+
+    // 'count' different words made of two words of 'base', sorted : a big lexicon with the letters of a real one.
+    inline std::vector<std::string> compound_words(const std::vector<std::string>& base, std::size_t count,
+                                                   unsigned seed = 1) {
+        std::mt19937 rng(seed);
+        std::vector<std::string> ret;
+        ret.reserve(count + count / 8);
+        while (ret.size() < count) {
+            for (std::size_t i = ret.size(); i < count + count / 8; ++i) {
+                ret.push_back(base[rng() % base.size()] + base[rng() % base.size()]);
+            }
+            std::sort(ret.begin(), ret.end());
+            ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+        }
+        // Drop random words rather than the tail, so that the list keeps every first letter.
+        std::shuffle(ret.begin(), ret.end(), rng);
+        ret.resize(count);
+        std::sort(ret.begin(), ret.end());
+        return ret;
+    }
+
+    // The word with one random edit : a letter changed, added or dropped
+    inline std::string typo(std::string word, std::mt19937& rng) {
+        const char letter = static_cast<char>('a' + rng() % 26);
+        const std::size_t pos = word.empty() ? 0 : rng() % word.size();
+        switch (word.empty() ? 1 : rng() % 3) {
+            case 0:  word[pos] = letter; break;
+            case 1:  word.insert(word.begin() + static_cast<std::ptrdiff_t>(pos), letter); break;
+            default: word.erase(pos, 1); break;
+        }
+        return word;
+    }
+
+    // 'count' words of 'base', a 'miss_rate' part of them with a typo
+    inline std::vector<std::string> queries(const std::vector<std::string>& base, std::size_t count, double miss_rate,
+                                            unsigned seed = 2) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> coin(0, 1);
+        std::vector<std::string> ret;
+        ret.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string word = base[rng() % base.size()];
+            ret.push_back(coin(rng) < miss_rate ? typo(std::move(word), rng) : std::move(word));
+        }
+        return ret;
+    }
+
+    // The best time of 'runs' calls of f, in milliseconds
+    template<typename F>
+    double best_ms(int runs, F&& f) {
+        double best = 1e300;
+        for (int i = 0; i < runs; ++i) {
+            const auto start = Clock::now();
+            f();
+            best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        return best;
+    }
+
+    // Same, in nanoseconds per operation, for a call of f doing 'ops' operations
+    template<typename F>
+    double best_ns_per(int runs, std::size_t ops, F&& f) {
+        return best_ms(runs, std::forward<F>(f)) * 1e6 / static_cast<double>(ops);
+    }
+
+    // Keep the compiler from dropping a result nobody reads
+    template<typename T>
+    void keep(const T& value) {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    inline void row(const std::string& name, double value, const std::string& unit) {
+        std::cout << "  " << std::left << std::setw(40) << name << std::right << std::setw(12) << std::fixed
+                  << std::setprecision(value < 10 ? 2 : 1) << value << " " << unit << std::endl;
+    }
+    inline void row(const std::string& name, std::size_t count, const std::string& unit = "") {
+        std::cout << "  " << std::left << std::setw(40) << name << std::right << std::setw(12) << count
+                  << " " << unit << std::endl;
+    }
+
+}
+
+#endif //OOPFINAL_BENCH_BENCH_H
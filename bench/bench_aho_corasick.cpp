@@ -0,0 +1,38 @@
+#include "bench.h"
+#include "aho_corasick.h"
+
+// One AhoCorasick scan against a std::string::find pass per pattern, over a 1 MB text of dictionary words.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    std::mt19937 rng(3);
+    std::string text;
+    while (text.size() < (1 << 20)) {
+        text += words[rng() % words.size()];
+        text += ' ';
+    }
+
+    std::cout << text.size() << " bytes of text" << std::endl;
+    for (const std::size_t n : {10, 100, 300, 1000}) {
+        std::vector<std::string> patterns;
+        for (std::size_t i = 0; i < n; ++i) {
+            patterns.push_back(words[rng() % words.size()]);
+        }
+        std::cout << n << " words to find" << std::endl;
+
+        bench::row("build", bench::best_ms(5, [&] { bench::keep(AhoCorasick(patterns)); }), "ms");
+        const AhoCorasick automaton(patterns);
+        bench::row("memory", static_cast<double>(automaton.memory_usage()) / 1e3, "KB");
+        bench::row("AhoCorasick::find_all", bench::best_ms(5, [&] {
+            bench::keep(automaton.find_all(text).size());
+        }), "ms");
+        bench::row("std::string::find per word", bench::best_ms(3, [&] {
+            std::size_t found = 0;
+            for (const auto& pattern : patterns) {
+                for (std::size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+                    ++found;
+                }
+            }
+            bench::keep(found);
+        }), "ms");
+    }
+}
@@ -0,0 +1,66 @@
+#include "bench.h"
+#include "lexicon.h"
+
+// Lexicon lookups with and without a BloomFilter in front, for more or fewer misspelled words, and the real false positive rates.
+namespace {
+
+    // Words made of random letters : almost none of them is in a dictionary.
+    std::vector<std::string> gibberish(std::size_t count) {
+        std::mt19937 rng(4);
+        std::vector<std::string> ret;
+        ret.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string word(5 + rng() % 6, 'a');
+            for (char& c : word) {
+                c = static_cast<char>('a' + rng() % 26);
+            }
+            ret.push_back(std::move(word));
+        }
+        return ret;
+    }
+
+    void compare(const std::vector<std::string>& words) {
+        Lexicon lexicon(words);
+        std::cout << words.size() << " words, 2M lookups" << std::endl;
+
+        for (double miss_rate : {0.9, 0.5, 0.0}) {
+            const std::vector<std::string> queries = bench::queries(words, 2000000, miss_rate);
+            const std::string name = std::to_string(static_cast<int>(miss_rate * 100)) + "% misspelled";
+
+            lexicon.drop_filter();
+            const std::vector<bool> found = lexicon.contains_many(queries);
+            const double plain = bench::best_ns_per(3, queries.size(), [&] { bench::keep(lexicon.contains_many(queries)); });
+            lexicon.build_filter(0.01);
+            if (lexicon.contains_many(queries) != found) {
+                std::cout << "  the filter changed an answer!" << std::endl;
+            }
+            const double filtered = bench::best_ns_per(3, queries.size(), [&] { bench::keep(lexicon.contains_many(queries)); });
+            bench::row(name + ", Lexicon alone", plain, "ns");
+            bench::row(name + ", with a 1% filter", filtered, "ns");
+        }
+
+        for (double rate : {0.01, 0.001}) {
+            lexicon.build_filter(rate);
+            const BloomFilter& filter = *lexicon.get_filter();
+            std::size_t passed = 0, misses = 0;
+            for (const auto& word : gibberish(1000000)) {
+                if (!lexicon._contains_(word)) {
+                    ++misses;
+                    passed += filter.may_contain(word);
+                }
+            }
+            const std::string target = rate == 0.01 ? "1%" : "0.1%";
+            bench::row("filter for " + target + ", memory", static_cast<double>(filter.memory_usage()) / 1e3, "KB");
+            bench::row("filter for " + target + ", computed rate", filter.false_positive_rate() * 100, "%");
+            bench::row("filter for " + target + ", measured rate",
+                       static_cast<double>(passed) / static_cast<double>(misses) * 100, "%");
+        }
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    compare(words);
+    compare(bench::compound_words(words, 1000000));
+}
@@ -0,0 +1,58 @@
+#include "bench.h"
+#include "lexicon.h"
+
+#include <queue>
+
+// The closeness search of Lexicon against scoring every word of the dictionary, on dict.txt and on a bigger lexicon.
+namespace {
+
+    // The 'count' best closeness values of a scan; the words do not matter for the time.
+    std::size_t scan(const Lexicon& lexicon, const std::string& input, int count) {
+        std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> best;
+        for (uint32_t id = 0; id < lexicon.size(); ++id) {
+            const std::string_view word = lexicon.word(id);
+            std::size_t prefix = 0, suffix = 0;
+            while (prefix < word.size() && prefix < input.size() && word[prefix] == input[prefix]) {
+                ++prefix;
+            }
+            while (suffix < word.size() && suffix < input.size()
+                   && word[word.size() - 1 - suffix] == input[input.size() - 1 - suffix]) {
+                ++suffix;
+            }
+            best.push(prefix + suffix);
+            if (best.size() > count) {
+                best.pop();
+            }
+        }
+        return best.empty() ? 0 : best.top();
+    }
+
+    void compare(const std::vector<std::string>& words) {
+        const Lexicon lexicon(words);
+        const std::vector<std::string> queries = bench::queries(words, 600, 1.0);
+        std::cout << lexicon.size() << " words, " << queries.size() << " misspelled queries" << std::endl;
+        for (int count : {5, 50}) {
+            bench::row("closeness search, k = " + std::to_string(count), bench::best_ns_per(3, queries.size(), [&] {
+                std::size_t found = 0;
+                for (const auto& q : queries) {
+                    found += lexicon.get_suggestions_by_closeness(q, count).size();
+                }
+                bench::keep(found);
+            }) / 1e3, "us");
+            bench::row("scan of every word, k = " + std::to_string(count), bench::best_ns_per(3, queries.size(), [&] {
+                std::size_t worst = 0;
+                for (const auto& q : queries) {
+                    worst += scan(lexicon, q, count);
+                }
+                bench::keep(worst);
+            }) / 1e3, "us");
+        }
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    compare(words);
+    compare(bench::compound_words(words, 300000));
+}
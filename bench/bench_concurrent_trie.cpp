@@ -0,0 +1,24 @@
+#include "bench.h"
+#include "trie.h"
+
+// What the concurrent mode costs a lookup : the same Trie, before and after enable_concurrent_readers().
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const std::vector<std::string> queries = bench::queries(words, 1000000, 0.5);
+    Trie trie(words);
+
+    auto lookups = [&] {
+        return bench::best_ns_per(5, queries.size(), [&] {
+            std::size_t hits = 0;
+            for (const auto& q : queries) {
+                hits += trie._contains_(q);
+            }
+            bench::keep(hits);
+        });
+    };
+
+    std::cout << queries.size() << " lookups, half of them misspelled" << std::endl;
+    bench::row("Trie::_contains_, default mode", lookups(), "ns");
+    trie.enable_concurrent_readers();
+    bench::row("Trie::_contains_, concurrent mode", lookups(), "ns");
+}
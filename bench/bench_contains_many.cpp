@@ -0,0 +1,45 @@
+#include "bench.h"
+#include "frozen_trie.h"
+#include "trie.h"
+
+// One lookup after another against the batched contains_many, on dict.txt and on a big lexicon made from it.
+namespace {
+
+    void compare(const std::vector<std::string>& words, const std::vector<std::string>& queries) {
+        const Trie trie(words);
+        const FrozenTrie frozen = trie.freeze();
+        std::cout << words.size() << " words, " << queries.size() << " lookups, a quarter misspelled" << std::endl;
+        bench::row("Trie memory", static_cast<double>(trie.memory_usage()) / 1e6, "MB");
+        bench::row("FrozenTrie memory", static_cast<double>(frozen.memory_usage()) / 1e6, "MB");
+
+        bench::row("Trie::_contains_", bench::best_ns_per(5, queries.size(), [&] {
+            std::size_t hits = 0;
+            for (const auto& q : queries) {
+                hits += trie._contains_(q);
+            }
+            bench::keep(hits);
+        }), "ns");
+        bench::row("Trie::contains_many", bench::best_ns_per(5, queries.size(), [&] {
+            bench::keep(trie.contains_many(queries));
+        }), "ns");
+        bench::row("FrozenTrie::_contains_", bench::best_ns_per(5, queries.size(), [&] {
+            std::size_t hits = 0;
+            for (const auto& q : queries) {
+                hits += frozen._contains_(q);
+            }
+            bench::keep(hits);
+        }), "ns");
+        bench::row("FrozenTrie::contains_many", bench::best_ns_per(5, queries.size(), [&] {
+            bench::keep(frozen.contains_many(queries));
+        }), "ns");
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    compare(words, bench::queries(words, 400000, 0.25));
+
+    const std::vector<std::string> big = bench::compound_words(words, 1500000);
+    compare(big, bench::queries(big, 400000, 0.25));
+}
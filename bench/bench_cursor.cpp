@@ -0,0 +1,71 @@
+#include "bench.h"
+#include "trie.h"
+
+// A Trie::Cursor against lookups from the root, per keystroke of typing long words letter by letter.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const Trie trie(words);
+    std::vector<std::string> typed;
+    std::size_t keystrokes = 0;
+    for (const auto& word : words) {
+        if (word.size() >= 12 && trie._contains_(word)) {
+            typed.push_back(word);
+            keystrokes += word.size();
+        }
+    }
+
+    const double cursor_is_word = bench::best_ns_per(5, keystrokes, [&] {
+        std::size_t hits = 0;
+        Trie::Cursor cursor = trie.cursor();
+        for (const auto& word : typed) {
+            cursor.reset();
+            for (const char c : word) {
+                cursor.advance(c);
+                hits += cursor.is_word();
+            }
+        }
+        bench::keep(hits);
+    });
+    const double rewalk_is_word = bench::best_ns_per(5, keystrokes, [&] {
+        std::size_t hits = 0;
+        std::string prefix;
+        for (const auto& word : typed) {
+            prefix.clear();
+            for (const char c : word) {
+                prefix += c;
+                hits += trie._contains_(prefix);
+            }
+        }
+        bench::keep(hits);
+    });
+    const double cursor_completions = bench::best_ns_per(3, keystrokes, [&] {
+        std::size_t count = 0;
+        Trie::Cursor cursor = trie.cursor();
+        for (const auto& word : typed) {
+            cursor.reset();
+            for (const char c : word) {
+                cursor.advance(c);
+                count += cursor.completions(5).size();
+            }
+        }
+        bench::keep(count);
+    });
+    const double rewalk_completions = bench::best_ns_per(3, keystrokes, [&] {
+        std::size_t count = 0;
+        std::string prefix;
+        for (const auto& word : typed) {
+            prefix.clear();
+            for (const char c : word) {
+                prefix += c;
+                count += trie.get_suggestions(prefix, 5).size();
+            }
+        }
+        bench::keep(count);
+    });
+
+    std::cout << typed.size() << " words of 12 letters or more, " << keystrokes << " keystrokes" << std::endl;
+    bench::row("Cursor::advance + is_word", cursor_is_word, "ns");
+    bench::row("Trie::_contains_(prefix)", rewalk_is_word, "ns");
+    bench::row("Cursor::advance + completions(5)", cursor_completions, "ns");
+    bench::row("Trie::get_suggestions(prefix, 5)", rewalk_completions, "ns");
+}
@@ -0,0 +1,31 @@
+#include "bench.h"
+#include "dawg.h"
+#include "frozen_trie.h"
+#include "trie.h"
+
+// The states and bytes of a Dawg against those of the Trie and the FrozenTrie of the same words.
+namespace {
+
+    void compare(const std::vector<std::string>& words) {
+        const Trie trie(words);
+        const FrozenTrie frozen = trie.freeze();
+        const Dawg dawg(words);
+
+        std::cout << words.size() << " words" << std::endl;
+        bench::row("Trie nodes", trie.node_num());
+        bench::row("FrozenTrie cells", frozen.size());
+        bench::row("Dawg states", dawg.node_num());
+        bench::row("Dawg edges", dawg.edge_num());
+        bench::row("Trie memory", trie.memory_usage(), "bytes");
+        bench::row("FrozenTrie memory", frozen.memory_usage(), "bytes");
+        bench::row("Dawg memory", dawg.memory_usage(), "bytes");
+        bench::row("build Dawg", bench::best_ms(3, [&] { bench::keep(Dawg(words)); }), "ms");
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    compare(words);
+    compare(bench::compound_words(words, 500000));
+}
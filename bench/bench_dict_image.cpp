@@ -0,0 +1,22 @@
+#include "bench.h"
+#include "dict_image.h"
+
+#include <filesystem>
+
+// Startup : building the Lexicon from the word list against mapping its compiled image, checks included.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const std::string path = (std::filesystem::temp_directory_path() / "oopfinal_bench_dict.img").string();
+    DictionaryImage::compile(words, path);
+
+    std::cout << words.size() << " words, an image of " << std::filesystem::file_size(path) << " bytes" << std::endl;
+    bench::row("build a Lexicon", bench::best_ms(10, [&] {
+        const Lexicon lexicon(words);
+        bench::keep(lexicon);
+    }), "ms");
+    bench::row("map the image", bench::best_ms(10, [&] {
+        const DictionaryImage image(path);
+        bench::keep(image);
+    }), "ms");
+    std::filesystem::remove(path);
+}
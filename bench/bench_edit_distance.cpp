@@ -0,0 +1,30 @@
+#include "bench.h"
+#include "edit_distance.h"
+#include "trie.h"
+
+// The suggestions within k edits : the banded walk of the Trie against computing the distance to every word.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const std::vector<std::string> queries = bench::queries(words, 200, 1.0);
+    const Trie trie(words);
+
+    std::cout << words.size() << " words, " << queries.size() << " misspelled queries" << std::endl;
+    for (int k = 1; k <= 2; ++k) {
+        bench::row("Trie walk, k = " + std::to_string(k), bench::best_ns_per(3, queries.size(), [&] {
+            std::size_t found = 0;
+            for (const auto& q : queries) {
+                found += mints::search_within_distance(trie, q, k).size();
+            }
+            bench::keep(found);
+        }) / 1e3, "us");
+        bench::row("scan of the list, k = " + std::to_string(k), bench::best_ns_per(3, queries.size(), [&] {
+            std::size_t found = 0;
+            for (const auto& q : queries) {
+                for (const auto& word : words) {
+                    found += mints::edit_distance(q, word) <= k;
+                }
+            }
+            bench::keep(found);
+        }) / 1e3, "us");
+    }
+}
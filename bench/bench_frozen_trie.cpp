@@ -0,0 +1,40 @@
+#include "bench.h"
+#include "frozen_trie.h"
+#include "trie.h"
+
+// A FrozenTrie against the Trie it is frozen from : its size, the time to freeze, and lookups.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const std::vector<std::string> queries = bench::queries(words, 1000000, 0.5);
+
+    const Trie trie(words);
+    const ReversedTrie reversed(words);
+    FrozenTrie frozen = trie.freeze();
+    const FrozenTrie frozen_reversed = reversed.freeze();
+
+    std::cout << words.size() << " words" << std::endl;
+    bench::row("Trie nodes", trie.node_num());
+    bench::row("FrozenTrie cells", frozen.size());
+    bench::row("ReversedTrie nodes", reversed.node_num());
+    bench::row("reversed FrozenTrie cells", frozen_reversed.size());
+    bench::row("Trie memory", static_cast<double>(trie.memory_usage()) / 1e6, "MB");
+    bench::row("FrozenTrie memory", static_cast<double>(frozen.memory_usage()) / 1e6, "MB");
+    bench::row("reversed FrozenTrie memory", static_cast<double>(frozen_reversed.memory_usage()) / 1e6, "MB");
+    bench::row("freeze Trie", bench::best_ms(5, [&] { frozen = trie.freeze(); }), "ms");
+
+    std::cout << queries.size() << " lookups, half of them misspelled" << std::endl;
+    bench::row("Trie::_contains_", bench::best_ns_per(5, queries.size(), [&] {
+        std::size_t hits = 0;
+        for (const auto& q : queries) {
+            hits += trie._contains_(q);
+        }
+        bench::keep(hits);
+    }), "ns");
+    bench::row("FrozenTrie::_contains_", bench::best_ns_per(5, queries.size(), [&] {
+        std::size_t hits = 0;
+        for (const auto& q : queries) {
+            hits += frozen._contains_(q);
+        }
+        bench::keep(hits);
+    }), "ns");
+}
@@ -0,0 +1,81 @@
+#include "bench.h"
+#include "hangul.h"
+#include "trie.h"
+
+// Lookups of a HangulTrie against those of its JamoTrie alone and of a Trie of ASCII words as long as the jamo words.
+int main() {
+    std::mt19937 rng(6);
+    auto syllable = [&rng] {
+        const char32_t cp = 0xAC00 + rng() % 11172;
+        std::string ret;
+        ret += static_cast<char>(0xE0 | cp >> 12);
+        ret += static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+        ret += static_cast<char>(0x80 | (cp & 0x3F));
+        return ret;
+    };
+
+    std::vector<std::string> words, letters, ascii;
+    for (int i = 0; i < 100000; ++i) {
+        std::string word;
+        for (int j = 2 + static_cast<int>(rng() % 3); j > 0; --j) {
+            word += syllable();
+        }
+        words.push_back(word);
+        letters.push_back(hangul::to_letters(word));
+        std::string same_length(letters.back().size(), 'a');
+        for (char& c : same_length) {
+            c = static_cast<char>('a' + rng() % 26);
+        }
+        ascii.push_back(same_length);
+    }
+    const HangulTrie hangul_trie(words);
+    std::vector<std::string> sorted_letters = letters, sorted_ascii = ascii;
+    std::sort(sorted_letters.begin(), sorted_letters.end());
+    std::sort(sorted_ascii.begin(), sorted_ascii.end());
+    const JamoTrie jamo_trie(sorted_letters);
+    const Trie ascii_trie(sorted_ascii);
+
+    // Half of the lookups are words of the tries, half of them random words of the same kind.
+    std::vector<std::size_t> picks;
+    for (int i = 0; i < 200000; ++i) {
+        picks.push_back(i % 2 == 0 ? rng() % words.size() : words.size());
+    }
+    std::vector<std::string> word_queries, letter_queries, ascii_queries;
+    std::size_t letter_num = 0;
+    for (const std::size_t pick : picks) {
+        const std::string word = pick < words.size() ? words[pick] : syllable() + syllable() + syllable();
+        word_queries.push_back(word);
+        letter_queries.push_back(hangul::to_letters(word));
+        letter_num += letter_queries.back().size();
+        std::string same_length = pick < words.size() ? ascii[pick] : std::string(letter_queries.back().size(), 'a');
+        if (pick >= words.size()) {
+            for (char& c : same_length) {
+                c = static_cast<char>('a' + rng() % 26);
+            }
+        }
+        ascii_queries.push_back(same_length);
+    }
+
+    std::cout << words.size() << " words, " << picks.size() << " lookups, half of them words" << std::endl;
+    bench::row("HangulTrie nodes", hangul_trie.node_num());
+    bench::row("ASCII Trie nodes", ascii_trie.node_num());
+    auto per_letter = [letter_num](const std::string& name, const auto& dict, const std::vector<std::string>& queries) {
+        bench::row(name + " per letter", bench::best_ns_per(5, letter_num, [&] {
+            std::size_t hits = 0;
+            for (const auto& q : queries) {
+                hits += dict._contains_(q);
+            }
+            bench::keep(hits);
+        }), "ns");
+    };
+    per_letter("JamoTrie::_contains_", jamo_trie, letter_queries);
+    per_letter("ASCII Trie::_contains_", ascii_trie, ascii_queries);
+    per_letter("HangulTrie::_contains_ (UTF-8)", hangul_trie, word_queries);
+    bench::row("hangul::to_letters per word", bench::best_ns_per(5, word_queries.size(), [&] {
+        std::size_t size = 0;
+        for (const auto& q : word_queries) {
+            size += hangul::to_letters(q).size();
+        }
+        bench::keep(size);
+    }), "ns");
+}
@@ -0,0 +1,68 @@
+#include "bench.h"
+#include "frozen_trie.h"
+#include "lexicon.h"
+#include "trie.h"
+
+// One Lexicon against the forward and the reversed FrozenTrie it replaces : their size, and the lookups of a spell-check.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const std::vector<std::string> queries = bench::queries(words, 20000, 0.5);
+
+    const Trie trie(words);
+    const ReversedTrie reversed(words);
+    const FrozenTrie frozen = trie.freeze();
+    const FrozenTrie frozen_reversed = reversed.freeze();
+    const Lexicon lexicon(words);
+
+    std::cout << words.size() << " words" << std::endl;
+    bench::row("Trie + ReversedTrie memory", static_cast<double>(trie.memory_usage() + reversed.memory_usage()) / 1e6, "MB");
+    bench::row("two FrozenTries memory", static_cast<double>(frozen.memory_usage() + frozen_reversed.memory_usage()) / 1e6, "MB");
+    bench::row("Lexicon memory", static_cast<double>(lexicon.memory_usage()) / 1e6, "MB");
+
+    // Up to 1000 suggestions a side, as StringHolder::spellcheck asks for
+    std::cout << queries.size() << " queries, half of them misspelled" << std::endl;
+    bench::row("two FrozenTries, prefix + suffix", bench::best_ns_per(3, queries.size(), [&] {
+        std::size_t found = 0;
+        for (const auto& q : queries) {
+            found += frozen.get_suggestions(q, 1000).size() + frozen_reversed.get_suggestions(q, 1000).size();
+        }
+        bench::keep(found);
+    }) / 1e3, "us");
+    bench::row("Lexicon, prefix + suffix", bench::best_ns_per(3, queries.size(), [&] {
+        std::size_t found = 0;
+        for (const auto& q : queries) {
+            found += lexicon.get_suggestions_by_prefix(q, 1000).size() + lexicon.get_suggestions_by_suffix(q, 1000).size();
+        }
+        bench::keep(found);
+    }) / 1e3, "us");
+    bench::row("FrozenTrie::_contains_", bench::best_ns_per(3, queries.size(), [&] {
+        std::size_t hits = 0;
+        for (const auto& q : queries) {
+            hits += frozen._contains_(q);
+        }
+        bench::keep(hits);
+    }), "ns");
+    bench::row("Lexicon::_contains_", bench::best_ns_per(3, queries.size(), [&] {
+        std::size_t hits = 0;
+        for (const auto& q : queries) {
+            hits += lexicon._contains_(q);
+        }
+        bench::keep(hits);
+    }), "ns");
+
+    const std::span<const std::string> few(queries.data(), 1000);
+    bench::row("FrozenTrie within 2 edits", bench::best_ns_per(3, few.size(), [&] {
+        std::size_t found = 0;
+        for (const auto& q : few) {
+            found += frozen.get_suggestions_within(q, 2, 1000).size();
+        }
+        bench::keep(found);
+    }) / 1e3, "us");
+    bench::row("Lexicon within 2 edits", bench::best_ns_per(3, few.size(), [&] {
+        std::size_t found = 0;
+        for (const auto& q : few) {
+            found += lexicon.get_suggestions_within(q, 2, 1000).size();
+        }
+        bench::keep(found);
+    }) / 1e3, "us");
+}
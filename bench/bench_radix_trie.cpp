@@ -0,0 +1,76 @@
+#include "bench.h"
+#include "radix_trie.h"
+#include "trie.h"
+
+// A RadixTrie against the Trie of the same words : nodes, bytes, the nodes a lookup goes through, and lookup times.
+namespace {
+
+    // The nodes a lookup of the word enters below the root of the Trie : one per letter found.
+    std::size_t lookup_depth(const Trie& trie, const std::string& word) {
+        std::size_t hops = 0;
+        for (const Node* node = trie.root_state(); hops < word.size(); ++hops) {
+            const int idx = Ascii26::index(word[hops]);
+            if (idx == -1 || (node = node->get_next(idx)) == nullptr) {
+                break;
+            }
+        }
+        return hops;
+    }
+
+    void compare(const std::vector<std::string>& words, const std::vector<std::string>& queries) {
+        const Trie trie(words);
+        const RadixTrie radix(words);
+
+        double trie_hops = 0, radix_hops = 0;
+        for (const auto& q : queries) {
+            trie_hops += static_cast<double>(lookup_depth(trie, q));
+            radix_hops += static_cast<double>(radix.lookup_depth(q));
+        }
+
+        std::cout << words.size() << " words, " << queries.size() << " lookups, a quarter misspelled" << std::endl;
+        bench::row("Trie nodes", trie.node_num());
+        bench::row("RadixTrie nodes", radix.node_num());
+        bench::row("Trie memory", trie.memory_usage(), "bytes");
+        bench::row("RadixTrie memory", radix.memory_usage(), "bytes");
+        bench::row("Trie lookup depth", trie_hops / static_cast<double>(queries.size()), "nodes");
+        bench::row("RadixTrie lookup depth", radix_hops / static_cast<double>(queries.size()), "nodes");
+        bench::row("Trie::_contains_", bench::best_ns_per(3, queries.size(), [&] {
+            std::size_t hits = 0;
+            for (const auto& q : queries) {
+                hits += trie._contains_(q);
+            }
+            bench::keep(hits);
+        }), "ns");
+        bench::row("RadixTrie::_contains_", bench::best_ns_per(3, queries.size(), [&] {
+            std::size_t hits = 0;
+            for (const auto& q : queries) {
+                hits += radix._contains_(q);
+            }
+            bench::keep(hits);
+        }), "ns");
+        const std::span<const std::string> few(queries.data(), 20000);
+        bench::row("Trie::get_suggestions", bench::best_ns_per(3, few.size(), [&] {
+            std::size_t found = 0;
+            for (const auto& q : few) {
+                found += trie.get_suggestions(q, 10).size();
+            }
+            bench::keep(found);
+        }) / 1e3, "us");
+        bench::row("RadixTrie::get_suggestions", bench::best_ns_per(3, few.size(), [&] {
+            std::size_t found = 0;
+            for (const auto& q : few) {
+                found += radix.get_suggestions(q, 10).size();
+            }
+            bench::keep(found);
+        }) / 1e3, "us");
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    compare(words, bench::queries(words, 200000, 0.25));
+
+    const std::vector<std::string> big = bench::compound_words(words, 500000);
+    compare(big, bench::queries(big, 200000, 0.25));
+}
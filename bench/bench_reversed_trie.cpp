@@ -0,0 +1,36 @@
+#include "bench.h"
+#include "trie.h"
+
+// Lookups and suggestions of a Trie and of a ReversedTrie, whose Transform reads every word from its last letter.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const std::vector<std::string> queries = bench::queries(words, 1000000, 0.5);
+    const std::vector<std::string> few(queries.begin(), queries.begin() + 100000);
+    const Trie trie(words);
+    const ReversedTrie reversed(words);
+
+    auto lookups = [&queries](const auto& dict) {
+        return bench::best_ns_per(5, queries.size(), [&] {
+            std::size_t hits = 0;
+            for (const auto& q : queries) {
+                hits += dict._contains_(q);
+            }
+            bench::keep(hits);
+        });
+    };
+    auto suggestions = [&few](const auto& dict) {
+        return bench::best_ns_per(3, few.size(), [&] {
+            std::size_t count = 0;
+            for (const auto& q : few) {
+                count += dict.get_suggestions(q, 10).size();
+            }
+            bench::keep(count);
+        });
+    };
+
+    std::cout << queries.size() << " lookups and " << few.size() << " suggestions, half of them misspelled" << std::endl;
+    bench::row("Trie::_contains_", lookups(trie), "ns");
+    bench::row("ReversedTrie::_contains_", lookups(reversed), "ns");
+    bench::row("Trie::get_suggestions(10)", suggestions(trie), "ns");
+    bench::row("ReversedTrie::get_suggestions(10)", suggestions(reversed), "ns");
+}
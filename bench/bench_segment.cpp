@@ -0,0 +1,20 @@
+#include "bench.h"
+#include "lexicon.h"
+
+// Lexicon::segment on one long run of dictionary words with no space between them.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const Lexicon lexicon(words);
+    std::mt19937 rng(4);
+    std::string text;
+    for (int i = 0; i < 20000; ++i) {
+        text += words[rng() % words.size()];
+    }
+
+    std::cout << "a run of 20000 words, " << text.size() << " letters" << std::endl;
+    std::size_t piece_num = 0;
+    const double ms = bench::best_ms(5, [&] { piece_num = lexicon.segment(text).size(); });
+    bench::row("split into", piece_num, "words");
+    bench::row("Lexicon::segment", ms, "ms");
+    bench::row("Lexicon::segment per letter", ms * 1e6 / static_cast<double>(text.size()), "ns");
+}
@@ -0,0 +1,70 @@
+#include "bench.h"
+#include "sharded_dict.h"
+
+#include <filesystem>
+
+// A ShardedDictionary of a big lexicon against the whole Trie : opening it, and checking a document of a few first letters.
+void run(const std::vector<std::string>& words) {
+    const std::string path = (std::filesystem::temp_directory_path() / "oopfinal_bench.shards").string();
+
+    std::cout << words.size() << " words" << std::endl;
+    std::unique_ptr<Trie> trie;
+    bench::row("build the whole Trie", bench::best_ms(3, [&] { trie = std::make_unique<Trie>(words); }), "ms");
+    bench::row("whole Trie memory", static_cast<double>(trie->memory_usage()) / 1e6, "MB");
+    trie.reset();
+    bench::row("compile the shards", bench::best_ms(1, [&] { ShardedDictionary::compile(words, path); }), "ms");
+    bench::row("open the shards", bench::best_ms(5, [&] { bench::keep(ShardedDictionary(path).size()); }), "ms");
+
+    // A document of 3000 words starting with 3 letters, a fifth of them misspelled
+    std::vector<std::string> by_letters;
+    for (const auto& word : words) {
+        if (word[0] == 'c' || word[0] == 'p' || word[0] == 's') {
+            by_letters.push_back(word);
+        }
+    }
+    const std::vector<std::string> document = bench::queries(by_letters, 3000, 0.2);
+
+    for (const std::size_t cap : {std::size_t{16}, ShardedDictionary::DEFAULT_MAX_RESIDENT}) {
+        std::cout << "3000 words of 'c', 'p' and 's', at most " << cap << " shards resident" << std::endl;
+        std::unique_ptr<ShardedDictionary> dict;
+        std::vector<bool> found;
+        bench::row("open and look up the words", bench::best_ms(3, [&] {
+            dict = std::make_unique<ShardedDictionary>(path, cap);
+            found = dict->contains_many(document);
+        }), "ms");
+        const std::size_t misses = std::count(found.begin(), found.end(), false);
+        bench::row("memory after the lookups", static_cast<double>(dict->memory_usage()) / 1e6, "MB");
+        bench::row("then suggest for the misspelled", bench::best_ms(1, [&] {
+            for (std::size_t i = 0; i < document.size(); ++i) {
+                if (!found[i]) {
+                    bench::keep(dict->get_suggestions(document[i], 10));
+                }
+            }
+        }), "ms");
+        bench::row("misspelled", misses);
+        bench::row("shards read", dict->shard_load_num());
+        bench::row("memory at the end", static_cast<double>(dict->memory_usage()) / 1e6, "MB");
+    }
+    std::filesystem::remove(path);
+}
+
+// Two lexicons of 1M words : pairs of real words, whose first letters are as uneven as English ones,
+// and random letters, which spread the words evenly over the shards.
+int main(int argc, char** argv) {
+    std::cout << "pairs of words" << std::endl;
+    run(bench::compound_words(bench::words(argc, argv), 1000000));
+
+    std::mt19937 rng(8);
+    std::vector<std::string> random_words;
+    for (int i = 0; i < 1000000; ++i) {
+        std::string word(5 + rng() % 8, 'a');
+        for (char& c : word) {
+            c = static_cast<char>('a' + rng() % 26);
+        }
+        random_words.push_back(word);
+    }
+    std::sort(random_words.begin(), random_words.end());
+    random_words.erase(std::unique(random_words.begin(), random_words.end()), random_words.end());
+    std::cout << "random letters" << std::endl;
+    run(random_words);
+}
@@ -0,0 +1,45 @@
+#include "bench.h"
+#include "lexicon.h"
+#include "trie.h"
+
+// What the lazy suggestions cost and save : copying suggestions against reading them one by one, and the closeness ranking.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const std::vector<std::string> queries = bench::queries(words, 20000, 0.5);
+    const Trie trie(words);
+    const Lexicon lexicon(words);
+
+    std::cout << words.size() << " words, " << queries.size() << " queries, half of them misspelled" << std::endl;
+    bench::row("Trie::get_suggestions(100)", bench::best_ns_per(3, queries.size(), [&] {
+        std::size_t found = 0;
+        for (const auto& q : queries) {
+            found += trie.get_suggestions(q, 100).size();
+        }
+        bench::keep(found);
+    }) / 1e3, "us");
+    bench::row("Trie::suggestions, 100 read", bench::best_ns_per(3, queries.size(), [&] {
+        std::size_t letters = 0;
+        for (const auto& q : queries) {
+            int read = 0;
+            for (std::string_view word : trie.suggestions(q)) {
+                letters += word.size();
+                if (++read == 100) {
+                    break;
+                }
+            }
+        }
+        bench::keep(letters);
+    }) / 1e3, "us");
+    bench::row("Trie::traverse, all the words", bench::best_ms(3, [&] {
+        bench::keep(trie.traverse(static_cast<int>(words.size())));
+    }), "ms");
+    for (int max : {5, 50}) {
+        bench::row("closeness, MAX = " + std::to_string(max), bench::best_ns_per(3, queries.size(), [&] {
+            std::size_t found = 0;
+            for (const auto& q : queries) {
+                found += lexicon.get_suggestions_by_closeness(q, max).size();
+            }
+            bench::keep(found);
+        }) / 1e3, "us");
+    }
+}
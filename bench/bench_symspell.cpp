@@ -0,0 +1,34 @@
+#include "bench.h"
+#include "frozen_trie.h"
+#include "symspell.h"
+#include "trie.h"
+
+// The symmetric-delete index against the walk of the Trie within 2 edits : its build, its size, and lookups.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const std::vector<std::string> queries = bench::queries(words, 3000, 0.7);
+    const Trie trie(words);
+    const FrozenTrie frozen = trie.freeze();
+
+    std::cout << words.size() << " words" << std::endl;
+    bench::row("build SymSpellIndex", bench::best_ms(3, [&] { bench::keep(SymSpellIndex(words)); }), "ms");
+    const SymSpellIndex index(words);
+    bench::row("SymSpellIndex memory", static_cast<double>(index.memory_usage()) / 1e6, "MB");
+    bench::row("FrozenTrie memory", static_cast<double>(frozen.memory_usage()) / 1e6, "MB");
+
+    std::cout << queries.size() << " queries, most of them misspelled" << std::endl;
+    bench::row("SymSpellIndex::get_suggestions", bench::best_ns_per(3, queries.size(), [&] {
+        std::size_t found = 0;
+        for (const auto& q : queries) {
+            found += index.get_suggestions(q, 1000).size();
+        }
+        bench::keep(found);
+    }) / 1e3, "us");
+    bench::row("Trie::get_suggestions_within, k = 2", bench::best_ns_per(3, queries.size(), [&] {
+        std::size_t found = 0;
+        for (const auto& q : queries) {
+            found += trie.get_suggestions_within(q, 2, 1000).size();
+        }
+        bench::keep(found);
+    }) / 1e3, "us");
+}
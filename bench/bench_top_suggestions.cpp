@@ -0,0 +1,51 @@
+#include "bench.h"
+#include "lexicon.h"
+#include "trie.h"
+
+#include <map>
+
+// The heaviest 10 words of a prefix, found best-first, against enumerating every word of the prefix and sorting them.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    std::mt19937 rng(16);
+    std::vector<uint32_t> weights;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        weights.push_back(static_cast<uint32_t>(rng() % 100000));
+    }
+    Trie trie(words);
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        trie.push(words[i], weights[i]);
+    }
+    // With all weights equal, the ties are broken alphabetically on every step.
+    Trie flat(words);
+    for (const auto& word : words) {
+        flat.push(word, 1);
+    }
+    const Lexicon lexicon(words, weights);
+    std::map<std::string, uint32_t, std::less<>> weight_of;
+    for (uint32_t id = 0; id < lexicon.size(); ++id) {
+        weight_of[std::string(lexicon.word(id))] = lexicon.weight(id);
+    }
+
+    for (const std::string prefix : {"", "st", "stan"}) {
+        const std::size_t run = trie.get_suggestions(prefix, INT32_MAX).size();
+        std::cout << "prefix '" << prefix << "' : " << run << " words" << std::endl;
+        bench::row("Trie::get_top_suggestions(10)", bench::best_ms(20, [&] {
+            bench::keep(trie.get_top_suggestions(prefix, 10));
+        }) * 1000, "us");
+        bench::row("Lexicon::get_top_suggestions(10)", bench::best_ms(20, [&] {
+            bench::keep(lexicon.get_top_suggestions(prefix, 10));
+        }) * 1000, "us");
+        bench::row("Trie, every word of weight 1", bench::best_ms(20, [&] {
+            bench::keep(flat.get_top_suggestions(prefix, 10));
+        }) * 1000, "us");
+        bench::row("enumerate and partial sort", bench::best_ms(20, [&] {
+            std::vector<std::string> all = trie.get_suggestions(prefix, INT32_MAX);
+            const auto middle = all.begin() + static_cast<std::ptrdiff_t>(std::min<std::size_t>(10, all.size()));
+            std::partial_sort(all.begin(), middle, all.end(), [&](const std::string& lhs, const std::string& rhs) {
+                return weight_of.find(lhs)->second > weight_of.find(rhs)->second;
+            });
+            bench::keep(all);
+        }) * 1000, "us");
+    }
+}
@@ -0,0 +1,52 @@
+#include "bench.h"
+#include "trie.h"
+
+#include <memory>
+#include <thread>
+
+// Building and dropping the tries of a word list : the cost the chunks of NodeArena are for.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const std::vector<std::string> big = bench::compound_words(words, 500000);
+
+    for (const auto* list : {&words, &big}) {
+        std::cout << list->size() << " words" << std::endl;
+
+        double build = 1e300;
+        for (int run = 0; run < 5; ++run) {
+            const auto start = bench::Clock::now();
+            auto trie = std::make_unique<Trie>(*list);
+            build = std::min(build, std::chrono::duration<double, std::milli>(bench::Clock::now() - start).count());
+        }   // The teardown is out of the clock.
+        bench::row("Trie build", build, "ms");
+
+        double pushes = 1e300;
+        for (int run = 0; run < 5; ++run) {
+            const auto start = bench::Clock::now();
+            auto trie = std::make_unique<Trie>();
+            for (const auto& word : *list) {
+                trie->push(word);
+            }
+            pushes = std::min(pushes, std::chrono::duration<double, std::milli>(bench::Clock::now() - start).count());
+        }
+        bench::row("Trie build by push", pushes, "ms");
+
+        const unsigned thread_num = std::max(2u, std::thread::hardware_concurrency());
+        double parallel = 1e300;
+        for (int run = 0; run < 5; ++run) {
+            const auto start = bench::Clock::now();
+            auto trie = std::make_unique<Trie>(*list, thread_num);
+            parallel = std::min(parallel, std::chrono::duration<double, std::milli>(bench::Clock::now() - start).count());
+        }
+        bench::row("Trie build, " + std::to_string(thread_num) + " threads", parallel, "ms");
+
+        bench::row("Trie build and teardown", bench::best_ms(5, [list] {
+            Trie trie(*list);
+            bench::keep(trie);
+        }), "ms");
+        bench::row("ReversedTrie build and teardown", bench::best_ms(5, [list] {
+            ReversedTrie trie(*list);
+            bench::keep(trie);
+        }), "ms");
+    }
+}
@@ -0,0 +1,19 @@
+#include "bench.h"
+#include "trie.h"
+
+// The size of a node, and the nodes and bytes of the tries of a word list (See the child block of Node.)
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const std::vector<std::string> big = bench::compound_words(words, 500000);
+
+    std::cout << "sizeof(Node) = " << sizeof(Node) << " bytes" << std::endl;
+    for (const auto* list : {&words, &big}) {
+        std::cout << list->size() << " words" << std::endl;
+        const Trie trie(*list);
+        const ReversedTrie reversed(*list);
+        bench::row("Trie nodes", trie.node_num());
+        bench::row("Trie memory", static_cast<double>(trie.memory_usage()) / 1e6, "MB");
+        bench::row("ReversedTrie nodes", reversed.node_num());
+        bench::row("ReversedTrie memory", static_cast<double>(reversed.memory_usage()) / 1e6, "MB");
+    }
+}
@@ -0,0 +1,48 @@
+#include "bench.h"
+#include "trie.h"
+#include "wildcard.h"
+
+// Trie::match against a scan of every word with the same compiled pattern, for all the matches and for the first 10.
+int main(int argc, char** argv) {
+    const std::vector<std::string> words = bench::words(argc, argv);
+    const Trie trie(words);
+    const ReversedTrie reversed(words);
+
+    auto scan = [&words](const std::string& pattern, std::size_t cap) {
+        const WildcardPattern compiled(pattern);
+        std::size_t found = 0;
+        for (const auto& word : words) {
+            if (compiled.matches(word) && ++found == cap) {
+                break;
+            }
+        }
+        return found;
+    };
+    auto search = [](const auto& dict, const std::string& pattern, std::size_t cap) {
+        std::size_t found = 0;
+        for (std::string_view word : dict.match(pattern)) {
+            bench::keep(word);
+            if (++found == cap) {
+                break;
+            }
+        }
+        return found;
+    };
+
+    std::cout << words.size() << " words" << std::endl;
+    for (const std::string pattern : {"cro?sw*d", "stan*", "[bc]?t", "*tion", "*q*"}) {
+        std::cout << "'" << pattern << "' : " << scan(pattern, words.size()) << " matches" << std::endl;
+        for (const std::size_t cap : {words.size(), std::size_t{10}}) {
+            const std::string suffix = cap == 10 ? ", first 10" : ", all";
+            bench::row("Trie::match" + suffix, bench::best_ms(20, [&] {
+                bench::keep(search(trie, pattern, cap));
+            }) * 1000, "us");
+            bench::row("ReversedTrie::match" + suffix, bench::best_ms(20, [&] {
+                bench::keep(search(reversed, pattern, cap));
+            }) * 1000, "us");
+            bench::row("scan" + suffix, bench::best_ms(20, [&] {
+                bench::keep(scan(pattern, cap));
+            }) * 1000, "us");
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#include "bloom_filter.h"
+#include "mint_utils.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+BloomFilter::BloomFilter(std::size_t block_num) : blocks(std::max<std::size_t>(block_num, 1)), key_num(0) {}
+
+uint64_t BloomFilter::hash(std::string_view key) {
+    // Eight letters at a time, then the murmur3 finalizer, so that both halves of the hash are well mixed.
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ key.size();
+    std::size_t i = 0;
+    for (; i + 8 <= key.size(); i += 8) {
+        uint64_t chunk;
+        std::memcpy(&chunk, key.data() + i, 8);
+        h = std::rotl((h ^ chunk) * 0xbf58476d1ce4e5b9ull, 31);
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, key.data() + i, key.size() - i);
+    h = (h ^ tail) * 0x94d049bb133111ebull;
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+std::size_t BloomFilter::block_index(uint64_t h) const {
+    // (high half) * block_num / 2^32 is in [0, block_num) without a division.
+    return ((h >> 32) * blocks.size()) >> 32;
+}
+
+std::array<uint64_t, BloomFilter::LANE_NUM> BloomFilter::masks_of(uint64_t h) {
+    const auto low = static_cast<uint32_t>(h);
+    std::array<uint64_t, LANE_NUM> masks{};
+    for (int i = 0; i < LANE_NUM; ++i) {
+        masks[i] = uint64_t{1} << ((low * SALT[i]) >> 26);
+    }
+    return masks;
+}
+
+double BloomFilter::expected_false_positive_rate(double bits_per_key) {
+    /*
+     The number of keys in a block follows a Poisson distribution with the mean 'lambda'.
+     With j keys in a block, a bit of a lane is set with the chance 1 - (63/64)^j, and a key never inserted
+     passes if its bit is set in all 8 lanes.
+     */
+    const double lambda = 512.0 / std::max(bits_per_key, 1.0);
+    const auto last = static_cast<int>(lambda + 12 * std::sqrt(lambda) + 16);
+    double rate = 0;
+    for (int j = 1; j <= last; ++j) {
+        const double poisson = std::exp(j * std::log(lambda) - lambda - std::lgamma(j + 1.0));
+        rate += poisson * std::pow(1 - std::pow(63.0 / 64.0, j), LANE_NUM);
+    }
+    return rate;
+}
+
+double BloomFilter::bits_per_key_for(double false_positive_rate) {
+    if (!(false_positive_rate > 0 && false_positive_rate < 1)) {
+        throw mints::input_out_of_range("The false positive rate must be in (0, 1) : {rate : "
+                                        + std::to_string(false_positive_rate) + "}");
+    }
+    // The expected rate falls as the bits per key grow, so binary search for the least bits reaching it.
+    double lo = 1, hi = 64;
+    if (expected_false_positive_rate(hi) > false_positive_rate) {
+        return hi;
+    }
+    for (int step = 0; step < 40; ++step) {
+        const double mid = (lo + hi) / 2;
+        if (expected_false_positive_rate(mid) <= false_positive_rate) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    return hi;
+}
+
+BloomFilter BloomFilter::for_false_positive_rate(std::size_t expected_keys, double false_positive_rate) {
+    const double bits = static_cast<double>(expected_keys) * bits_per_key_for(false_positive_rate);
+    return BloomFilter(static_cast<std::size_t>(std::ceil(bits / 512)));
+}
+
+BloomFilter BloomFilter::for_memory(std::size_t max_bytes) {
+    return BloomFilter(max_bytes / sizeof(Block));
+}
+
+void BloomFilter::insert(std::string_view key) {
+    const uint64_t h = hash(key);
+    Block& block = blocks[block_index(h)];
+    const auto masks = masks_of(h);
+    for (int i = 0; i < LANE_NUM; ++i) {
+        block.lanes[i] |= masks[i];
+    }
+    ++key_num;
+}
+
+bool BloomFilter::may_contain(std::string_view key) const {
+    const uint64_t h = hash(key);
+    const Block& block = blocks[block_index(h)];
+    const auto masks = masks_of(h);
+    // One OR over all the lanes instead of a branch per lane : the key passes iff no bit of its masks is missing.
+    uint64_t missing = 0;
+    for (int i = 0; i < LANE_NUM; ++i) {
+        missing |= masks[i] & ~block.lanes[i];
+    }
+    return missing == 0;
+}
+
+double BloomFilter::false_positive_rate() const {
+    // A random key falls into each block with the same chance, and passes if its bit is set in every lane.
+    double sum = 0;
+    for (const auto& block : blocks) {
+        double pass = 1;
+        for (uint64_t lane : block.lanes) {
+            pass *= std::popcount(lane) / 64.0;
+        }
+        sum += pass;
+    }
+    return sum / static_cast<double>(blocks.size());
+}
+
+std::size_t BloomFilter::size() const {
+    return key_num;
+}
+
+std::size_t BloomFilter::memory_usage() const {
+    return sizeof(BloomFilter) + blocks.capacity() * sizeof(Block);
+}
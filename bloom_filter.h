@@ -0,0 +1,69 @@
+#ifndef OOPFINAL_BLOOM_FILTER_H
+#define OOPFINAL_BLOOM_FILTER_H
+
+#include <array>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+class BloomFilter {
+    /*
+     "BloomFilter" answers "is this word possibly in the set?" : "no" is always right, "yes" is wrong with a small chance,
+     the false positive rate. Put in front of a dictionary, it turns most lookups of a misspelled word into one
+     hash and one memory access, and only the words it lets through are looked up in the dictionary itself.
+
+     It is a blocked Bloom filter : the bits are split into blocks of one cache line (64 bytes), and all the bits of a key
+     lie in one block chosen by its hash, so a lookup touches one cache line wherever the key is.
+     A block is 8 lanes of 64 bits, and a key sets exactly one bit in each lane (so k = 8 bits per key) :
+        block = hash * block_num / 2^64                         (by the high half of the hash)
+        bit of lane i = (low half of the hash * SALT[i]) >> 26  (6 bits : 0 to 63)
+     The 8 lanes are independent, so the probe is the same few operations on 8 lanes, without a branch :
+     make the 8 masks, AND them with the block, and compare. Compilers turn this loop into vector instructions.
+
+     Putting the bits of a key into one block costs some accuracy, because blocks do not get the same number of keys.
+     For a false positive rate of 1% it takes about 10.1 bits per key, against 9.6 for a plain Bloom filter.
+     The size is set by a target false positive rate or by a memory budget (See for_false_positive_rate, for_memory.)
+     Keys can only be added, never removed, so it suits a dictionary which does not change once built.
+     It pays off when many lookups miss : every lookup pays for the hash, and only a miss saves the dictionary lookup.
+     */
+    static constexpr int LANE_NUM = 8;
+    static constexpr std::array<uint32_t, LANE_NUM> SALT = {
+            0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+            0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+    };
+
+    struct alignas(64) Block {
+        std::array<uint64_t, LANE_NUM> lanes;
+    };
+
+    std::vector<Block>  blocks;
+    std::size_t         key_num;
+
+    explicit BloomFilter(std::size_t block_num);
+
+    [[nodiscard]] static uint64_t hash(std::string_view key);
+    [[nodiscard]] std::size_t block_index(uint64_t h) const;
+    [[nodiscard]] static std::array<uint64_t, LANE_NUM> masks_of(uint64_t h);
+
+public:
+    // Bits per key needed to get the given false positive rate with 'k = 8' and 512-bit blocks
+    [[nodiscard]] static double bits_per_key_for(double false_positive_rate);
+    // The false positive rate expected with 'bits_per_key' bits per key
+    [[nodiscard]] static double expected_false_positive_rate(double bits_per_key);
+
+    // An empty filter sized for 'expected_keys' keys at the given false positive rate
+    [[nodiscard]] static BloomFilter for_false_positive_rate(std::size_t expected_keys, double false_positive_rate);
+    // An empty filter taking at most 'max_bytes' bytes (and at least one block)
+    [[nodiscard]] static BloomFilter for_memory(std::size_t max_bytes);
+
+    void insert(std::string_view key);
+    // False if the key was never inserted; true if it was, or with the false positive rate if it was not.
+    [[nodiscard]] bool may_contain(std::string_view key) const;
+
+    // The chance that a key never inserted passes, computed from the bits actually set
+    [[nodiscard]] double false_positive_rate() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+#endif //OOPFINAL_BLOOM_FILTER_H
@@ -0,0 +1,228 @@
+#include "dawg.h"
+#include "trie.h"
+#include "edit_distance.h"
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+
+    // A state while building : the transitions are kept in the order they were added, which is alphabetical.
+    struct BuildState {
+        bool                                    final = false;
+        std::vector<std::pair<char, uint32_t>>  edges;
+    };
+
+    // Two states are equivalent iff they are both final or not, and have the same transitions to the same states.
+    std::string signature(const BuildState& state) {
+        std::string key(1, state.final ? '1' : '0');
+        for (auto [c, target] : state.edges) {
+            key += c;
+            key.append(reinterpret_cast<const char*>(&target), sizeof(target));
+        }
+        return key;
+    }
+
+}
+
+Dawg::Dawg(const std::vector<std::string> &words) {
+    std::vector<std::string> sorted;
+    sorted.reserve(words.size());
+    for (const auto& word : words) {
+        if (std::all_of(word.begin(), word.end(), [](char c) { return Ascii26::index(c) != -1; })) {
+            sorted.push_back(word);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::vector<BuildState> states(1);
+    std::vector<uint32_t> free_states;
+    // The states already known to be in the minimal automaton, by their signature
+    std::unordered_map<std::string, uint32_t> registered;
+
+    // path[i] is the state reached by the first i letters of the previous word; only these may still change.
+    std::vector<uint32_t> path{0};
+
+    // Merge or register the states of the path below the first 'length' letters, from the deepest one up.
+    auto minimize = [&](std::size_t length) {
+        while (path.size() > length + 1) {
+            const uint32_t child = path.back();
+            path.pop_back();
+            auto [it, inserted] = registered.try_emplace(signature(states[child]), child);
+            if (!inserted) {
+                states[path.back()].edges.back().second = it->second;
+                states[child] = BuildState();
+                free_states.push_back(child);
+            }
+        }
+    };
+
+    std::string_view previous;
+    for (const auto& word : sorted) {
+        std::size_t shared = 0;
+        while (shared < previous.size() && shared < word.size() && previous[shared] == word[shared]) {
+            ++shared;
+        }
+        minimize(shared);
+
+        for (std::size_t i = shared; i < word.size(); ++i) {
+            uint32_t next;
+            if (free_states.empty()) {
+                next = static_cast<uint32_t>(states.size());
+                states.emplace_back();
+            } else {
+                next = free_states.back();
+                free_states.pop_back();
+            }
+            states[path.back()].edges.emplace_back(word[i], next);
+            path.push_back(next);
+        }
+        states[path.back()].final = true;
+        previous = word;
+    }
+    minimize(0);
+
+    // Number the states again in breadth-first order, and pack them.
+    std::vector<uint32_t> new_id(states.size(), UINT32_MAX);
+    std::vector<uint32_t> order{0};
+    new_id[0] = 0;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        for (auto [c, target] : states[order[i]].edges) {
+            if (new_id[target] == UINT32_MAX) {
+                new_id[target] = static_cast<uint32_t>(order.size());
+                order.push_back(target);
+            }
+        }
+    }
+
+    edge_info.reserve(order.size() + 1);
+    for (uint32_t old_id : order) {
+        const BuildState& state = states[old_id];
+        edge_info.push_back(static_cast<uint32_t>(labels.size()) | (state.final ? FINAL_BIT : 0));
+        for (auto [c, target] : state.edges) {
+            labels.push_back(c);
+            targets.push_back(new_id[target]);
+        }
+    }
+    edge_info.push_back(static_cast<uint32_t>(labels.size()));
+
+    labels.shrink_to_fit();
+    targets.shrink_to_fit();
+}
+
+uint32_t Dawg::first_edge(uint32_t state) const {
+    return edge_info[state] & ~FINAL_BIT;
+}
+
+bool Dawg::is_final(uint32_t state) const {
+    return edge_info[state] & FINAL_BIT;
+}
+
+int64_t Dawg::step(uint32_t state, char c) const {
+    // The labels of a state are sorted, and there are at most 26 of them.
+    for (uint32_t i = first_edge(state); i < first_edge(state + 1) && labels[i] <= c; ++i) {
+        if (labels[i] == c) {
+            return targets[i];
+        }
+    }
+    return -1;
+}
+
+std::vector<std::string> Dawg::traverse(uint32_t state, std::string prefix, const int MAX_VEC_SIZE) const {
+    std::vector<std::string> vecstr;
+    vecstr.reserve(std::min(MAX_VEC_SIZE, Node::RESERVE_LIMIT));
+
+    // Do Depth-First-Search, spelling the words along the path.
+    // Each entry of the stack is (state, length of the path to its parent, letter leading to the state).
+    std::vector<std::tuple<uint32_t, std::size_t, char>> stack;
+    stack.emplace_back(state, prefix.size(), 0);
+
+    while (!stack.empty()) {
+        auto [popped, len, c] = stack.back();
+        stack.pop_back();
+
+        prefix.resize(len);
+        if (c != 0) {
+            prefix += c;
+        }
+
+        if (is_final(popped)) {
+            vecstr.push_back(prefix);
+            if (vecstr.size() >= MAX_VEC_SIZE) {
+                break;
+            }
+        }
+
+        // Push in reverse, so that the words come out alphabetically.
+        for (uint32_t i = first_edge(popped + 1); i > first_edge(popped); --i) {
+            stack.emplace_back(targets[i - 1], prefix.size(), labels[i - 1]);
+        }
+    }
+
+    return vecstr;
+}
+
+bool Dawg::_contains_(std::string_view input) const {
+    uint32_t state = 0;
+    for (char c : input) {
+        const int64_t next = step(state, c);
+        if (next == -1) {
+            return false;
+        }
+        state = static_cast<uint32_t>(next);
+    }
+    return is_final(state);
+}
+
+std::vector<std::string> Dawg::get_suggestions(const std::string &input, const int MAX_SUGGESTIONS) const {
+    // Find the closest prefix in our dictionary
+    uint32_t state = 0;
+    std::size_t level = 0;
+    for (; level < input.size(); ++level) {
+        const int64_t next = step(state, input[level]);
+        if (next == -1) {
+            break;
+        }
+        state = static_cast<uint32_t>(next);
+    }
+    // Load all strings with same prefixes in our dictionary
+    return traverse(state, input.substr(0, level), MAX_SUGGESTIONS);
+}
+
+std::vector<std::string> Dawg::traverse(const int MAX_VEC_SIZE) const {
+    return traverse(0, "", MAX_VEC_SIZE);
+}
+
+std::vector<std::string> Dawg::get_suggestions_within(const std::string &input, const int max_distance,
+                                                      const int MAX_SUGGESTIONS) const {
+    std::vector<std::string> ret;
+    for (auto& [word, distance] : mints::search_within_distance(*this, input, max_distance)) {
+        if (ret.size() >= MAX_SUGGESTIONS) {
+            break;
+        }
+        ret.push_back(std::move(word));
+    }
+    return ret;
+}
+
+uint32_t Dawg::root_state() const {
+    return 0;
+}
+
+bool Dawg::is_end_state(uint32_t state) const {
+    return is_final(state);
+}
+
+std::size_t Dawg::node_num() const {
+    return edge_info.size() - 1;
+}
+
+std::size_t Dawg::edge_num() const {
+    return labels.size();
+}
+
+std::size_t Dawg::memory_usage() const {
+    return sizeof(Dawg) + edge_info.capacity() * sizeof(uint32_t) + labels.capacity() + targets.capacity() * sizeof(uint32_t);
+}
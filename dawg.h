@@ -0,0 +1,80 @@
+#ifndef OOPFINAL_DAWG_H
+#define OOPFINAL_DAWG_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "mint_utils.h"
+
+class Dawg {
+    /*
+     "Dawg" (directed acyclic word graph) is a read-only dictionary like FrozenTrie, but with the common suffixes shared too.
+     In a trie every word has its own path below the point where it leaves the others, so "-ation" is stored once per word
+     ending with it. A DAWG merges every two states which accept the same set of endings, so it is the smallest automaton
+     accepting exactly the words of the dictionary.
+     i.e. for {"tap", "taps", "top", "tops"}, a trie has 7 states below the root, but a DAWG has only 4 :
+            trie                    DAWG
+            t - a - p - s           t - a - p - s
+             \                           \ /
+              o - p - s                   o
+
+     It is built with the incremental algorithm of Daciuk et al. from the words in sorted order.
+     When a word is added, the part of the previous word that the new word does not share is final, since no later word
+     (which is alphabetically larger) can add anything below it; so those states are merged right away with an equal state
+     already seen, or kept as new ones. Thus the automaton is minimal at every step and never much bigger than the result.
+
+     After the build, the states are numbered again in breadth-first order and packed into flat arrays :
+     the transitions of the state s are labels[i] -> targets[i] for i in [first_edge(s), first_edge(s + 1)), sorted by label.
+     The state 0 is the start. A state cannot keep its word, since many words may end at the same state;
+     traversals spell the words along the path, as FrozenTrie does.
+     */
+    static constexpr uint32_t FINAL_BIT = 1u << 31;
+
+    // edge_info[s] is the first edge of s, with FINAL_BIT set if a word ends at s; edge_info[state_num] closes the last state.
+    std::vector<uint32_t>   edge_info;
+    std::vector<char>       labels;
+    std::vector<uint32_t>   targets;
+
+public:
+    // Words with characters other than 'a' to 'z' are skipped, like Trie::push does. The words need not be sorted.
+    explicit Dawg(const std::vector<std::string>& words);
+
+private:
+    [[nodiscard]] uint32_t first_edge(uint32_t state) const;
+    [[nodiscard]] bool is_final(uint32_t state) const;
+    // Returns the target of the transition of 'state' by 'c', or -1 if there is none.
+    [[nodiscard]] int64_t step(uint32_t state, char c) const;
+
+    // Collect the words below 'state'; 'prefix' is the path from the start to 'state'.
+    [[nodiscard]] std::vector<std::string> traverse(uint32_t state, std::string prefix, int MAX_VEC_SIZE) const;
+
+public:
+    [[nodiscard]] bool _contains_(std::string_view input) const;
+
+    // Same as Trie::get_suggestions : the words sharing the longest prefix with the input, alphabetically.
+    [[nodiscard]] std::vector<std::string> get_suggestions(const std::string& input, int MAX_SUGGESTIONS) const;
+    [[nodiscard]] std::vector<std::string> traverse(int MAX_VEC_SIZE) const;
+
+    // Same as Trie::get_suggestions_within (See edit_distance.h.)
+    [[nodiscard]] std::vector<std::string> get_suggestions_within(const std::string& input, int max_distance,
+                                                                  int MAX_SUGGESTIONS) const;
+
+    // Walking functions used by the search algorithms : a 'state' of a Dawg is a state number.
+    [[nodiscard]] uint32_t root_state() const;
+    [[nodiscard]] bool is_end_state(uint32_t state) const;
+    template<typename F>
+    void for_each_child(uint32_t state, F&& f) const {
+        for (uint32_t i = first_edge(state); i < first_edge(state + 1); ++i) {
+            f(labels[i], targets[i]);
+        }
+    }
+
+    // The number of states and of transitions
+    [[nodiscard]] std::size_t node_num() const;
+    [[nodiscard]] std::size_t edge_num() const;
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+#endif //OOPFINAL_DAWG_H
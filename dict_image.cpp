@@ -0,0 +1,182 @@
+#include "dict_image.h"
+#include "trie.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+    uint64_t aligned(uint64_t offset) {
+        return (offset + 7) & ~static_cast<uint64_t>(7);
+    }
+
+    /*
+     Whether the arrays of an image hold a Lexicon, so that no lookup reads out of them : the words lie in the pool one
+     after another, are made of 'a' to 'z', and are sorted without duplicates (the buckets and every binary search count on it),
+     and by_suffix holds every id once. It reads every array once, which is still far less than building a Lexicon.
+     */
+    bool holds_lexicon(const uint32_t* offsets, const uint32_t* by_suffix, const char* pool, uint64_t word_num,
+                       uint64_t pool_size) {
+        if (offsets[0] != 0 || offsets[word_num] != pool_size) {
+            return false;
+        }
+        for (uint64_t id = 0; id < word_num; ++id) {
+            if (offsets[id] > offsets[id + 1]) {
+                return false;
+            }
+        }
+        for (uint64_t i = 0; i < pool_size; ++i) {
+            if (Ascii26::index(pool[i]) == -1) {
+                return false;
+            }
+        }
+        for (uint64_t id = 1; id < word_num; ++id) {
+            const std::string_view previous(pool + offsets[id - 1], offsets[id] - offsets[id - 1]);
+            const std::string_view current(pool + offsets[id], offsets[id + 1] - offsets[id]);
+            if (!(previous < current)) {
+                return false;
+            }
+        }
+
+        std::vector<bool> seen(word_num, false);
+        for (uint64_t i = 0; i < word_num; ++i) {
+            if (by_suffix[i] >= word_num || seen[by_suffix[i]]) {
+                return false;
+            }
+            seen[by_suffix[i]] = true;
+        }
+        return true;
+    }
+
+}
+
+DictionaryImage::DictionaryImage(const std::string &path)
+        : mapped(nullptr), mapped_size(0), lexicon_ptr(nullptr) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw mints::unable_to_open_file("Unable to open file : {name : " + path + "}");
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) == -1 || st.st_size < sizeof(Header)) {
+        close(fd);
+        throw mints::invalid_file_format("Not a dictionary image : {name : " + path + "}");
+    }
+
+    mapped_size = st.st_size;
+    mapped = mmap(nullptr, mapped_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping keeps the file alive, so the descriptor is not needed any more.
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw mints::unable_to_open_file("Unable to map file : {name : " + path + "}");
+    }
+
+    const auto* bytes = static_cast<const unsigned char*>(mapped);
+    const auto* header = reinterpret_cast<const Header*>(bytes);
+
+    // Every array must be aligned and lie inside the file, and what they hold must be a Lexicon.
+    auto fits = [this](uint64_t offset, uint64_t size) {
+        return offset % 8 == 0 && offset >= sizeof(Header) && offset <= mapped_size && size <= mapped_size - offset;
+    };
+    const bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 && header->version == VERSION
+                       && header->word_num < UINT32_MAX && header->pool_size < UINT32_MAX
+                       && fits(header->offsets_offset, (header->word_num + 1) * sizeof(uint32_t))
+                       && fits(header->by_suffix_offset, header->word_num * sizeof(uint32_t))
+                       && fits(header->pool_offset, header->pool_size)
+                       && (header->weights_offset == 0 || fits(header->weights_offset, header->word_num * sizeof(uint32_t)))
+                       && holds_lexicon(reinterpret_cast<const uint32_t*>(bytes + header->offsets_offset),
+                                        reinterpret_cast<const uint32_t*>(bytes + header->by_suffix_offset),
+                                        reinterpret_cast<const char*>(bytes + header->pool_offset),
+                                        header->word_num, header->pool_size);
+    if (!valid) {
+        munmap(mapped, mapped_size);
+        throw mints::invalid_file_format("Not a dictionary image : {name : " + path + "}");
+    }
+
+    lexicon_ptr = new Lexicon(reinterpret_cast<const uint32_t*>(bytes + header->offsets_offset),
+                              reinterpret_cast<const uint32_t*>(bytes + header->by_suffix_offset),
+                              reinterpret_cast<const char*>(bytes + header->pool_offset), header->word_num,
+                              header->weights_offset == 0 ? nullptr
+                                                          : reinterpret_cast<const uint32_t*>(bytes + header->weights_offset));
+}
+
+DictionaryImage::~DictionaryImage() {
+    delete lexicon_ptr;
+    if (mapped != nullptr) {
+        munmap(mapped, mapped_size);
+    }
+}
+
+void DictionaryImage::compile(const std::vector<std::string> &words, const std::string &path) {
+    write(Lexicon(words), path);
+}
+
+void DictionaryImage::compile(const std::vector<std::string> &words, const std::vector<uint32_t> &weights,
+                              const std::string &path) {
+    write(Lexicon(words, weights), path);
+}
+
+void DictionaryImage::write(const Lexicon &lexicon, const std::string &path) {
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.word_num = lexicon.size();
+    header.pool_size = lexicon.pool_size();
+    header.offsets_offset = aligned(sizeof(Header));
+    header.by_suffix_offset = header.offsets_offset + aligned((header.word_num + 1) * sizeof(uint32_t));
+    header.pool_offset = header.by_suffix_offset + aligned(header.word_num * sizeof(uint32_t));
+    header.weights_offset = lexicon.weights == nullptr ? 0 : header.pool_offset + aligned(header.pool_size);
+
+    // Written aside and renamed over the old image, so that the processes which map the old one keep their pages,
+    // and no process maps a half-written image (See mints::replace_file.)
+    mints::replace_file(path, [&](std::ostream& ofile) {
+        // Write 'size' bytes from 'src', then pad with zeros up to the next multiple of 8.
+        auto put = [&ofile](const void* src, uint64_t size) {
+            static constexpr char zeros[8]{};
+            ofile.write(static_cast<const char*>(src), static_cast<std::streamsize>(size));
+            ofile.write(zeros, static_cast<std::streamsize>(aligned(size) - size));
+        };
+
+        put(&header, sizeof(Header));
+        put(lexicon.offsets, (header.word_num + 1) * sizeof(uint32_t));
+        put(lexicon.by_suffix, header.word_num * sizeof(uint32_t));
+        put(lexicon.pool, header.pool_size);
+        if (lexicon.weights != nullptr) {
+            put(lexicon.weights, header.word_num * sizeof(uint32_t));
+        }
+    });
+}
+
+bool DictionaryImage::is_up_to_date(const std::string &image_path, const std::string &source_path) {
+    std::error_code ec;
+    const auto image_time = std::filesystem::last_write_time(image_path, ec);
+    if (ec) {
+        return false;
+    }
+
+    // An image of another version has to be compiled again, however new it is.
+    Header header{};
+    std::ifstream ifile(image_path, std::ios::binary);
+    if (!ifile.read(reinterpret_cast<char*>(&header), sizeof(Header))
+        || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        return false;
+    }
+
+    const auto source_time = std::filesystem::last_write_time(source_path, ec);
+    // Without the source there is nothing to rebuild from, so the image is the best we have.
+    return ec || source_time <= image_time;
+}
+
+void DictionaryImage::build_filter(double false_positive_rate) {
+    lexicon_ptr->build_filter(false_positive_rate);
+}
+
+const Lexicon &DictionaryImage::lexicon() const {
+    return *lexicon_ptr;
+}
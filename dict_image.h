@@ -0,0 +1,74 @@
+#ifndef OOPFINAL_DICT_IMAGE_H
+#define OOPFINAL_DICT_IMAGE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "mint_utils.h"
+#include "lexicon.h"
+
+class DictionaryImage {
+    /*
+     "DictionaryImage" is a compiled dictionary file holding a Lexicon.
+     Instead of reading dict.txt and building the dictionary on every launch, we compile it once into an image
+     and map the image into memory with mmap on later launches. The Lexicon is a view right on the mapped pages,
+     so loading is just mapping a file, and every process using the same image shares its pages through the page cache.
+
+     The image uses only offsets from the beginning of the file, never pointers, so it can be mapped at any address.
+     Layout :
+        Header                  (magic, version, the sizes, and where each array starts)
+        offsets                 (word_num + 1 entries)
+        by_suffix               (word_num entries)
+        pool                    (pool_size letters)
+        weights                 (word_num entries, only if the words have weights)
+     Every array starts at a multiple of 8 bytes.
+     Version 1 held a forward and a reversed FrozenTrie instead, and version 2 had no weights; such an image is just compiled again.
+     */
+    static constexpr char       MAGIC[8] = {'M', 'I', 'N', 'T', 'D', 'I', 'C', 'T'};
+    static constexpr uint32_t   VERSION = 3;
+
+    struct Header {
+        char        magic[8];
+        uint32_t    version;
+        uint32_t    reserved;
+        uint64_t    word_num;
+        uint64_t    pool_size;
+        uint64_t    offsets_offset;
+        uint64_t    by_suffix_offset;
+        uint64_t    pool_offset;
+        uint64_t    weights_offset;     // 0 if the words have no weights
+    };
+
+    void*       mapped;
+    std::size_t mapped_size;
+    Lexicon*    lexicon_ptr;
+
+public:
+    // Map a compiled image. Throws if the file cannot be opened or is not a valid image.
+    explicit    DictionaryImage(const std::string& path);
+                ~DictionaryImage();
+
+    DictionaryImage(const DictionaryImage&) = delete;
+    DictionaryImage& operator=(const DictionaryImage&) = delete;
+
+    /*
+     Build a Lexicon from the given words, and their weights if any (See Lexicon), and write it into an image.
+     The image replaces the one at 'path' only once it is complete (See mints::replace_file), so a process mapping
+     the old image keeps reading it.
+     */
+    static void compile(const std::vector<std::string>& words, const std::string& path);
+    static void compile(const std::vector<std::string>& words, const std::vector<uint32_t>& weights, const std::string& path);
+    static void write(const Lexicon& lexicon, const std::string& path);
+
+    // Whether the image exists, has the current version, and is not older than the word list it came from.
+    [[nodiscard]] static bool is_up_to_date(const std::string& image_path, const std::string& source_path);
+
+    // Put a BloomFilter in front of the lookups of the Lexicon (See Lexicon::build_filter.) It is made in memory from
+    // the mapped words, and is not a part of the image.
+    void build_filter(double false_positive_rate);
+
+    [[nodiscard]] const Lexicon& lexicon() const;
+};
+
+#endif //OOPFINAL_DICT_IMAGE_H
@@ -202,6 +202,30 @@ void Document::remove_holder(int idx) {
     holders.erase(holders.begin() + idx);
 }
 
+std::vector<std::pair<int, std::vector<AhoCorasick::Match>>> Document::find_all(const AhoCorasick &patterns) const {
+    std::vector<std::pair<int, std::vector<AhoCorasick::Match>>> found;
+    for (int i = 0; i < holders.size(); ++i) {
+        if (holders[i]->get_type() != Holder::STRING_HOLDER) {
+            continue;
+        }
+        auto matches = dynamic_cast<const StringHolder*>(holders[i])->find_all(patterns);
+        if (!matches.empty()) {
+            found.emplace_back(i, std::move(matches));
+        }
+    }
+    return found;
+}
+
+int Document::replace_all(const AhoCorasick &patterns, const std::vector<std::string> &replacements) {
+    int replaced = 0;
+    for (Holder* p : holders) {
+        if (p->get_type() == Holder::STRING_HOLDER) {
+            replaced += dynamic_cast<StringHolder*>(p)->replace_all(patterns, replacements);
+        }
+    }
+    return replaced;
+}
+
 std::string Document::save() const {
     std::stringstream ss;
     ss << filename << "\n\n";
@@ -30,6 +30,15 @@ public:
     void                        pop_holder();
     void                        remove_holder(int idx);
 
+    /*
+     Find or replace the patterns in every StringHolder, scanning each of them once (See AhoCorasick.)
+     find_all returns the index of each StringHolder having an occurrence, with its occurrences;
+     replace_all returns the number of words replaced in the whole document.
+     */
+    [[nodiscard]] std::vector<std::pair<int, std::vector<AhoCorasick::Match>>>
+                                find_all(const AhoCorasick& patterns) const;
+    int                         replace_all(const AhoCorasick& patterns, const std::vector<std::string>& replacements);
+
     [[nodiscard]] std::string   save() const;
 
     Holder*                     at(int idx);
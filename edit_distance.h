@@ -0,0 +1,128 @@
+#ifndef OOPFINAL_EDIT_DISTANCE_H
+#define OOPFINAL_EDIT_DISTANCE_H
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace mints {
+
+    /**
+     * The 'optimal string alignment' distance between two words : the number of insertions, deletions, substitutions
+     * and transpositions of two adjacent letters needed to turn one into the other. i.e. "teh" and "the" are 1 apart.
+     */
+    inline int edit_distance(std::string_view a, std::string_view b) {
+        const auto width = b.size() + 1;
+        // Three rows are enough : a transposition looks two rows back.
+        std::vector<int> before_above(width), above(width), row(width);
+        for (int j = 0; j < width; ++j) {
+            above[j] = j;
+        }
+
+        for (int i = 1; i <= a.size(); ++i) {
+            row[0] = i;
+            for (int j = 1; j < width; ++j) {
+                const int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+                row[j] = std::min({above[j] + 1, row[j - 1] + 1, above[j - 1] + cost});
+                if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                    row[j] = std::min(row[j], before_above[j - 2] + 1);
+                }
+            }
+            std::swap(before_above, above);
+            std::swap(above, row);
+        }
+
+        return above[width - 1];
+    }
+
+    /**
+     * Walks down a dictionary trie and finds every word within max_distance edits of the given word (See edit_distance().)
+     * Each node on the path gets one row of the distance table, computed from the row of its parent,
+     * so words sharing a prefix share the work. Only the band of 2 * max_distance + 1 cells around the diagonal
+     * is computed, and when every value of a row exceeds max_distance, no word below that node can come close enough,
+     * so the whole subtree is skipped.
+     *
+     * @tparam Walker Trie or FrozenTrie : anything with root_state(), is_end_state(s) and for_each_child(s, f)
+     * @param walker trie to walk
+     * @param word already preprocessed word
+     * @param max_distance the bound k
+     * @return (word, distance) pairs sorted by distance, and alphabetically for the same distance
+     */
+    template<typename Walker>
+    std::vector<std::pair<std::string, int>> search_within_distance(const Walker& walker, const std::string& word,
+                                                                    int max_distance) {
+        using State = decltype(walker.root_state());
+        const auto width = static_cast<int>(word.size()) + 1;
+
+        std::vector<std::pair<std::string, int>> found;
+
+        // rows[d] is the row of the node at depth d on the current path; path holds the letters of that path.
+        std::vector<std::vector<int>> rows(1, std::vector<int>(width));
+        for (int j = 0; j < width; ++j) {
+            rows[0][j] = j;
+        }
+        std::string path;
+
+        // Each entry of the stack is (state, depth, letter of the state).
+        std::vector<std::tuple<State, int, char>> stack;
+        walker.for_each_child(walker.root_state(), [&stack](char c, State child) {
+            stack.emplace_back(child, 1, c);
+        });
+        std::reverse(stack.begin(), stack.end());
+
+        while (!stack.empty()) {
+            auto [state, depth, c] = stack.back();
+            stack.pop_back();
+
+            path.resize(depth - 1);
+            path += c;
+            if (rows.size() <= depth) {
+                rows.emplace_back(width);
+            }
+
+            // Only the cells within max_distance of the diagonal can be max_distance or less; the others are just 'too far'.
+            const int too_far = max_distance + 1;
+            const int j_begin = std::max(1, depth - max_distance);
+            const int j_end = std::min(width - 1, depth + max_distance);
+
+            const std::vector<int>& above = rows[depth - 1];
+            std::vector<int>& row = rows[depth];
+            std::fill(row.begin(), row.end(), too_far);
+            row[0] = std::min(depth, too_far);
+            int row_min = row[0];
+            for (int j = j_begin; j <= j_end; ++j) {
+                const int cost = word[j - 1] == c ? 0 : 1;
+                row[j] = std::min({above[j] + 1, row[j - 1] + 1, above[j - 1] + cost, too_far});
+                if (depth > 1 && j > 1 && word[j - 1] == path[depth - 2] && word[j - 2] == c) {
+                    row[j] = std::min(row[j], rows[depth - 2][j - 2] + 1);
+                }
+                row_min = std::min(row_min, row[j]);
+            }
+
+            if (walker.is_end_state(state) && row[width - 1] <= max_distance) {
+                found.emplace_back(path, row[width - 1]);
+            }
+            if (row_min > max_distance) {
+                continue;
+            }
+
+            const auto children_begin = static_cast<long>(stack.size());
+            walker.for_each_child(state, [&stack, depth](char next_c, State child) {
+                stack.emplace_back(child, depth + 1, next_c);
+            });
+            std::reverse(stack.begin() + children_begin, stack.end());
+        }
+
+        // The stack visits words in alphabetical order, so a stable sort keeps that order among the same distances.
+        std::stable_sort(found.begin(), found.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second < rhs.second;
+        });
+        return found;
+    }
+
+}
+
+#endif //OOPFINAL_EDIT_DISTANCE_H
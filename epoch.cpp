@@ -0,0 +1,55 @@
+#include "epoch.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+EpochDomain::Guard::Guard(Guard &&other) noexcept : slot(other.slot) {
+    other.slot = nullptr;
+}
+
+EpochDomain::Guard::~Guard() {
+    if (slot != nullptr) {
+        slot->epoch.store(IDLE, std::memory_order_release);
+        slot->taken.store(false, std::memory_order_release);
+    }
+}
+
+EpochDomain::Guard EpochDomain::pin() const {
+    // Threads start looking from different slots, so they rarely fight over the same one.
+    const std::size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    for (std::size_t i = 0; ; ++i) {
+        Slot& slot = slots[(start + i) % MAX_READERS];
+        if (slot.taken.load(std::memory_order_relaxed) || slot.taken.exchange(true, std::memory_order_acquire)) {
+            if (i % MAX_READERS == MAX_READERS - 1) {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+
+        /*
+         Publish the epoch, then check that it is still the current one.
+         If a writer started a new epoch in between, it may have looked at our slot before we wrote it,
+         so we pin the new epoch instead; a writer can only free what was retired before the epoch we end up with.
+         */
+        uint64_t epoch = global_epoch.load();
+        slot.epoch.store(epoch);
+        while (global_epoch.load() != epoch) {
+            epoch = global_epoch.load();
+            slot.epoch.store(epoch);
+        }
+        return Guard(&slot);
+    }
+}
+
+uint64_t EpochDomain::current() const {
+    return global_epoch.load();
+}
+
+uint64_t EpochDomain::synchronize() {
+    uint64_t oldest = global_epoch.fetch_add(1) + 1;
+    for (const Slot& slot : slots) {
+        oldest = std::min(oldest, slot.epoch.load());
+    }
+    return oldest;
+}
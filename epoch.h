@@ -0,0 +1,62 @@
+#ifndef OOPFINAL_EPOCH_H
+#define OOPFINAL_EPOCH_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+class EpochDomain {
+    /*
+     "EpochDomain" tells a writer when the memory it has unlinked from a shared structure can be freed.
+     A reader 'pins' the current epoch for the duration of one lookup, and unpins it when the lookup is over.
+     A writer never frees what it unlinks right away : it 'retires' it, tagged with the epoch of that moment.
+     Later, synchronize() starts a new epoch and returns the oldest epoch some reader is still pinned at;
+     anything retired before that epoch cannot be reached by any reader, since every reader who could have seen it is gone.
+     i.e. a writer replaces a child array at epoch 5 and retires the old one with tag 5.
+          A reader pinned at 5 may still be reading the old array, so it is kept while that reader stays.
+          A reader pinned at 6 started after the replacement, so it can only see the new array.
+
+     Readers never wait for writers, and writers never wait for readers; the cost of a slow reader is only memory held longer.
+     At most MAX_READERS lookups can be pinned at the same time; one more just spins until a slot is free.
+     */
+public:
+    static constexpr int MAX_READERS = 64;
+
+private:
+    static constexpr uint64_t IDLE = UINT64_MAX;
+
+    // One slot per pinned reader, each on its own cache line so that readers do not slow each other down.
+    struct alignas(64) Slot {
+        std::atomic<bool>       taken{false};
+        std::atomic<uint64_t>   epoch{IDLE};
+    };
+
+    std::atomic<uint64_t> global_epoch{1};
+    mutable std::array<Slot, MAX_READERS> slots;
+
+public:
+    class Guard {
+        Slot* slot;  // nullptr if nothing is pinned
+    public:
+        explicit Guard(Slot* _slot = nullptr) : slot(_slot) {}
+        Guard(Guard&& other) noexcept;
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard();
+    };
+
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // Pin the current epoch until the returned guard dies.
+    [[nodiscard]] Guard pin() const;
+
+    // The tag of whatever a writer retires now.
+    [[nodiscard]] uint64_t current() const;
+
+    // Start a new epoch, and return the oldest epoch a reader is still pinned at. What was retired before it can be freed.
+    [[nodiscard]] uint64_t synchronize();
+};
+
+#endif //OOPFINAL_EPOCH_H
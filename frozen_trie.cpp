@@ -0,0 +1,304 @@
+#include "frozen_trie.h"
+#include "trie.h"
+#include "edit_distance.h"
+
+#include <array>
+#include <queue>
+#include <tuple>
+
+FrozenTrie::FrozenTrie(const Node &root, std::function<std::string(std::string)> f, std::function<std::string(std::string)> g)
+        : base_data(1, 0), check_data(1, 0), mask_data(1, 0), preprocess(std::move(f)), backprocess(std::move(g)) {
+    // While building, the arrays are only the vectors; base, check and mask point at them once we are done.
+    auto& base = base_data;
+    auto& check = check_data;
+    auto& mask = mask_data;
+
+    // Breadth-First-Search over the Trie; every popped node already owns a state, and we find room for its children.
+    std::queue<std::pair<const Node*, int32_t>> queue;
+    queue.emplace(&root, 0);
+
+    // Every cell before first_free is taken, so the search for a new base never starts below it.
+    int32_t first_free = 1;
+
+    while (!queue.empty()) {
+        auto [node, state] = queue.front();
+        queue.pop();
+
+        if (node->is_end()) {
+            mask[state] |= END_BIT;
+        }
+
+        const Node::Children children = node->get_children();
+        const int children_num = children.size();
+        if (children_num == 0) {
+            continue;
+        }
+
+        // Find the smallest base b such that b + c is an empty cell for every child c.
+        const int first_code = children[0]->get_char() - 96;
+        int32_t b;
+        for (int32_t t = first_free; ; ++t) {
+            if (t < check.size() && check[t] != -1) {
+                continue;
+            }
+            b = t - first_code;
+
+            bool fits = true;
+            for (int i = 1; i < children_num; ++i) {
+                int32_t cell = b + children[i]->get_char() - 96;
+                if (cell < check.size() && check[cell] != -1) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (fits) {
+                break;
+            }
+        }
+
+        base[state] = b;
+        const int32_t last_cell = b + children[children_num - 1]->get_char() - 96;
+        if (last_cell >= check.size()) {
+            base.resize(last_cell + 1, 0);
+            check.resize(last_cell + 1, -1);
+            mask.resize(last_cell + 1, 0);
+        }
+
+        for (int i = 0; i < children_num; ++i) {
+            const Node* child = children[i];
+            const int code = child->get_char() - 96;
+            check[b + code] = state;
+            mask[state] |= 1u << (code - 1);
+            queue.emplace(child, b + code);
+        }
+
+        while (first_free < check.size() && check[first_free] != -1) {
+            ++first_free;
+        }
+    }
+
+    base.shrink_to_fit();
+    check.shrink_to_fit();
+    mask.shrink_to_fit();
+
+    this->base = base.data();
+    this->check = check.data();
+    this->mask = mask.data();
+    cells = check.size();
+}
+
+FrozenTrie::FrozenTrie(const int32_t *_base, const int32_t *_check, const uint32_t *_mask, std::size_t _cells,
+                       std::function<std::string(std::string)> f, std::function<std::string(std::string)> g)
+        : base(_base), check(_check), mask(_mask), cells(_cells), preprocess(std::move(f)), backprocess(std::move(g)) {}
+
+int32_t FrozenTrie::step(int32_t state, char c) const {
+    if (c < 97 || c > 122) {
+        return -1;
+    }
+    const int32_t t = base[state] + (c - 96);
+    if (0 < t && t < cells && check[t] == state) {
+        return t;
+    }
+    return -1;
+}
+
+std::pair<int32_t, int> FrozenTrie::deepest_state_so_far(const std::string &str) const {
+    int32_t state = 0;
+    int level = 0;
+    for (char c : str) {
+        const int32_t next = step(state, c);
+        if (next == -1) {
+            break;
+        }
+        state = next;
+        ++level;
+    }
+    return {state, level};
+}
+
+std::vector<std::string> FrozenTrie::traverse(int32_t state, std::string prefix, const int MAX_VEC_SIZE) const {
+    std::vector<std::string> vecstr;
+    vecstr.reserve(std::min(MAX_VEC_SIZE, Node::RESERVE_LIMIT));
+
+    // Do Depth-First-Search; the words are not stored anywhere, so we rebuild them along the path.
+    // Each entry of the stack is (state, length of the path to its parent, alphabet of the state).
+    const auto start_len = static_cast<int>(prefix.size());
+    std::vector<std::tuple<int32_t, int, char>> stack;
+    stack.emplace_back(state, start_len, 0);
+
+    while (!stack.empty()) {
+        auto [popped, len, c] = stack.back();
+        stack.pop_back();
+
+        prefix.resize(len);
+        if (c != 0) {
+            prefix += c;
+        }
+
+        if (mask[popped] & END_BIT) {
+            vecstr.push_back(prefix);
+            if (vecstr.size() >= MAX_VEC_SIZE) {
+                break;
+            }
+        }
+
+        for (int code = 25; code >= 0; --code) {
+            if (mask[popped] >> code & 1u) {
+                stack.emplace_back(base[popped] + code + 1, static_cast<int>(prefix.size()), static_cast<char>(97 + code));
+            }
+        }
+    }
+
+    return vecstr;
+}
+
+bool FrozenTrie::_contains_(const std::string &input) const {
+    const std::string str = preprocess(input);
+
+    int32_t state = 0;
+    for (char c : str) {
+        state = step(state, c);
+        if (state == -1) {
+            return false;
+        }
+    }
+    return mask[state] & END_BIT;
+}
+
+std::vector<bool> FrozenTrie::contains_many(std::span<const std::string> inputs) const {
+    std::vector<bool> found(inputs.size(), false);
+
+    if (cells * (2 * sizeof(int32_t) + sizeof(uint32_t)) <= CACHE_RESIDENT_BYTES) {
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            found[i] = _contains_(inputs[i]);
+        }
+        return found;
+    }
+
+    /*
+     A lane is one lookup on its way down. Each turn of a lane does one of two steps :
+     1. base[state] is loaded, so compute the candidate cell t of the next letter and prefetch check[t] and base[t];
+     2. check[t] is loaded, so see whether t really is the child.
+     When a lookup is over, the lane takes the next input.
+     */
+    struct Lane {
+        std::string str;
+        std::size_t idx = 0, pos = 0;
+        int32_t state = -1;     // -1 for an idle lane
+        int32_t candidate = -1; // the cell t between the two steps, -1 otherwise
+    };
+    std::array<Lane, BATCH_LANES> lanes;
+    std::size_t next_input = 0;
+
+    auto start = [&](Lane& lane) {
+        if (next_input == inputs.size()) {
+            lane.state = -1;
+            return;
+        }
+        lane.idx = next_input++;
+        lane.str = preprocess(inputs[lane.idx]);
+        lane.pos = 0;
+        lane.state = 0;
+        lane.candidate = -1;
+    };
+
+    int active = 0;
+    for (Lane& lane : lanes) {
+        start(lane);
+        active += lane.state != -1;
+    }
+
+    while (active > 0) {
+        for (Lane& lane : lanes) {
+            if (lane.state == -1) {
+                continue;
+            }
+
+            if (lane.candidate == -1) {
+                if (lane.pos == lane.str.size()) {
+                    found[lane.idx] = mask[lane.state] & END_BIT;
+                } else if (const char c = lane.str[lane.pos++]; 97 <= c && c <= 122) {
+                    const int32_t t = base[lane.state] + (c - 96);
+                    if (0 < t && t < cells) {
+                        __builtin_prefetch(check + t);
+                        __builtin_prefetch(base + t);
+                        lane.candidate = t;
+                        continue;
+                    }
+                }
+            } else {
+                const int32_t t = lane.candidate;
+                lane.candidate = -1;
+                if (check[t] == lane.state) {
+                    lane.state = t;
+                    if (lane.pos == lane.str.size()) {
+                        __builtin_prefetch(mask + t);
+                    }
+                    continue;
+                }
+            }
+
+            // This lookup is over; a miss leaves found[idx] false.
+            start(lane);
+            active -= lane.state == -1;
+        }
+    }
+
+    return found;
+}
+
+std::vector<std::string> FrozenTrie::get_suggestions(const std::string &input, const int MAX_SUGGESTIONS) const {
+    const std::string to_search = preprocess(input);
+
+    // Find the closest prefix in our dictionary
+    auto [state, level] = deepest_state_so_far(to_search);
+    // Load all strings with same prefixes in our dictionary
+    std::vector<std::string> ret = traverse(state, to_search.substr(0, level), MAX_SUGGESTIONS);
+
+    for (auto& i : ret) {
+        i = backprocess(i);
+    }
+
+    return ret;
+}
+
+std::vector<std::string> FrozenTrie::traverse(const int MAX_VEC_SIZE) const {
+    return traverse(0, "", MAX_VEC_SIZE);
+}
+
+std::vector<std::string> FrozenTrie::get_suggestions_within(const std::string &input, const int max_distance,
+                                                            const int MAX_SUGGESTIONS) const {
+    std::vector<std::string> ret;
+    for (auto& [word, distance] : mints::search_within_distance(*this, preprocess(input), max_distance)) {
+        if (ret.size() >= MAX_SUGGESTIONS) {
+            break;
+        }
+        ret.push_back(backprocess(word));
+    }
+    return ret;
+}
+
+int32_t FrozenTrie::root_state() const {
+    return 0;
+}
+
+bool FrozenTrie::is_end_state(int32_t state) const {
+    return mask[state] & END_BIT;
+}
+
+std::size_t FrozenTrie::size() const {
+    return cells;
+}
+
+std::size_t FrozenTrie::memory_usage() const {
+    return sizeof(FrozenTrie) + base_data.capacity() * sizeof(int32_t) + check_data.capacity() * sizeof(int32_t)
+           + mask_data.capacity() * sizeof(uint32_t);
+}
+
+const std::function<std::string(std::string)>& FrozenTrie::get_preprocess() const {
+    return preprocess;
+}
+
+const std::function<std::string(std::string)>& FrozenTrie::get_backprocess() const {
+    return backprocess;
+}
@@ -0,0 +1,101 @@
+#ifndef OOPFINAL_FROZEN_TRIE_H
+#define OOPFINAL_FROZEN_TRIE_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <bit>
+#include <span>
+
+#include "mint_utils.h"
+
+class Node;
+
+class FrozenTrie {
+    /*
+     "FrozenTrie" is a read-only copy of a Trie, compiled into a double-array (BASE/CHECK) layout.
+     Every node of the Trie becomes an integer 'state', and the root is the state 0.
+     The child of the state s for the alphabet c (a = 1, b = 2, ... z = 26) is the state t = base[s] + c,
+     and it really exists only when check[t] == s. So one step of a lookup is two array loads, with no pointer to chase.
+     i.e. if the Trie is given like this:
+            #      (state 0, base 0)
+           / \
+          a   b    (state 1 and 2)
+     then base[0] + 1 == 1 and base[0] + 2 == 2, so check[1] == check[2] == 0.
+     mask[s] keeps the alphabets of the children of s at bit 0..25 (to visit them in order without trying all 26),
+     and bit 31 of mask[s] tells whether s is an end node.
+     A FrozenTrie cannot be modified; make a new one with Trie::freeze() instead.
+
+     The three arrays are read through plain pointers, so they may live either in the vectors owned by this object
+     or in memory owned by someone else, such as a mapped file.
+     */
+    static constexpr uint32_t END_BIT = 1u << 31;
+    static constexpr int BATCH_LANES = 16;
+    // Arrays up to this size stay in the cache after a few lookups; then there is no memory wait for a batch to hide.
+    static constexpr std::size_t CACHE_RESIDENT_BYTES = 1 << 20;
+
+    const int32_t*          base;
+    const int32_t*          check;
+    const uint32_t*         mask;
+    std::size_t             cells;
+    // Storage of the arrays when this FrozenTrie owns them; empty for a view on borrowed memory.
+    std::vector<int32_t>    base_data, check_data;
+    std::vector<uint32_t>   mask_data;
+    std::function<std::string(std::string)> preprocess, backprocess;
+
+public:
+    FrozenTrie(const Node& root, std::function<std::string(std::string)> f, std::function<std::string(std::string)> g);
+    // A view on arrays owned by someone else; they must outlive this FrozenTrie.
+    FrozenTrie(const int32_t* _base, const int32_t* _check, const uint32_t* _mask, std::size_t _cells,
+               std::function<std::string(std::string)> f, std::function<std::string(std::string)> g);
+
+    FrozenTrie(FrozenTrie&&) = default;
+    FrozenTrie& operator=(FrozenTrie&&) = default;
+    FrozenTrie(const FrozenTrie&) = delete;
+    FrozenTrie& operator=(const FrozenTrie&) = delete;
+
+private:
+    // Returns the child state, or -1 if there is no such child.
+    [[nodiscard]] int32_t step(int32_t state, char c) const;
+
+    // Same as Trie::deepest_node_so_far : returns the deepest state on the way to 'str' and its level.
+    [[nodiscard]] std::pair<int32_t, int> deepest_state_so_far(const std::string& str) const;
+
+    // Collect the words below 'state'; 'prefix' is the path from the root to 'state'.
+    [[nodiscard]] std::vector<std::string> traverse(int32_t state, std::string prefix, int MAX_VEC_SIZE) const;
+
+public:
+    [[nodiscard]] bool _contains_(const std::string& input) const;
+    // Same as Trie::contains_many : BATCH_LANES lookups go down together, and each prefetches its next cells.
+    // A FrozenTrie small enough to stay in the cache is just looked up word by word, which is faster then.
+    [[nodiscard]] std::vector<bool> contains_many(std::span<const std::string> inputs) const;
+    [[nodiscard]] std::vector<std::string> get_suggestions(const std::string& input, int MAX_SUGGESTIONS) const;
+    [[nodiscard]] std::vector<std::string> traverse(int MAX_VEC_SIZE) const;
+
+    // Same as Trie::get_suggestions_within (See edit_distance.h.)
+    [[nodiscard]] std::vector<std::string> get_suggestions_within(const std::string& input, int max_distance,
+                                                                  int MAX_SUGGESTIONS) const;
+
+    // Walking functions used by the search algorithms : a 'state' of a FrozenTrie is an index of the double array.
+    [[nodiscard]] int32_t root_state() const;
+    [[nodiscard]] bool is_end_state(int32_t state) const;
+    template<typename F>
+    void for_each_child(int32_t state, F&& f) const {
+        for (uint32_t m = mask[state] & ~END_BIT; m != 0; m &= m - 1) {
+            const int code = std::countr_zero(m);
+            f(static_cast<char>(97 + code), base[state] + code + 1);
+        }
+    }
+
+    // Number of cells in the double array; some of them are empty holes.
+    [[nodiscard]] std::size_t size() const;
+    // Bytes owned by this object; a view on borrowed memory owns only itself.
+    [[nodiscard]] std::size_t memory_usage() const;
+
+    // getter functions
+    [[nodiscard]] const std::function<std::string(std::string)>& get_preprocess() const;
+    [[nodiscard]] const std::function<std::string(std::string)>& get_backprocess() const;
+};
+
+#endif //OOPFINAL_FROZEN_TRIE_H
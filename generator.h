@@ -0,0 +1,108 @@
+#ifndef OOPFINAL_GENERATOR_H
+#define OOPFINAL_GENERATOR_H
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace mints {
+
+    /**
+     * A lazy sequence made by a coroutine : the body runs only as far as the caller reads, one co_yield at a time.
+     * i.e. a DFS written as a coroutine hands out its words one by one, and stops where the caller stops reading.
+     *
+     * The yielded value is not copied : *it refers to the operand of the last co_yield, which lives in the coroutine
+     * until it goes on. So a yielded std::string_view may point into a buffer of the coroutine; keep a copy of it
+     * if it must outlive the next ++it.
+     *
+     * A Generator is an input range (for-range loops, std::ranges::views::take, ...) and can be read once.
+     * @tparam T type of the yielded values
+     */
+    template<typename T>
+    class Generator {
+    public:
+        struct promise_type {
+            const T*            current = nullptr;
+            std::exception_ptr  exception;
+
+            Generator get_return_object() {
+                return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            std::suspend_always yield_value(const T& value) noexcept {
+                current = std::addressof(value);
+                return {};
+            }
+            void return_void() noexcept {}
+            void unhandled_exception() { exception = std::current_exception(); }
+
+            // A generator only yields; it never waits for anything.
+            template<typename U>
+            std::suspend_never await_transform(U&&) = delete;
+        };
+
+        class iterator {
+            std::coroutine_handle<promise_type> handle;
+        public:
+            using iterator_concept  = std::input_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = T;
+
+            iterator() = default;
+            explicit iterator(std::coroutine_handle<promise_type> _handle) : handle(_handle) {}
+
+            const T& operator*() const { return *handle.promise().current; }
+            iterator& operator++() {
+                handle.resume();
+                if (handle.promise().exception) {
+                    std::rethrow_exception(handle.promise().exception);
+                }
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) { return it.handle.done(); }
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+        explicit Generator(std::coroutine_handle<promise_type> _handle) : handle(_handle) {}
+
+    public:
+        Generator(Generator&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+        Generator& operator=(Generator&& other) noexcept {
+            if (this != &other) {
+                if (handle) {
+                    handle.destroy();
+                }
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+        Generator(const Generator&) = delete;
+        Generator& operator=(const Generator&) = delete;
+        ~Generator() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+        // Runs the body up to its first co_yield.
+        iterator begin() {
+            handle.resume();
+            if (handle.promise().exception) {
+                std::rethrow_exception(handle.promise().exception);
+            }
+            return iterator(handle);
+        }
+        [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+    };
+
+}
+
+#endif //OOPFINAL_GENERATOR_H
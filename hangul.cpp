@@ -0,0 +1,277 @@
+#include "hangul.h"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+
+    using hangul::CONSONANT_NUM;
+    using hangul::VOWEL_NUM;
+    using hangul::JAMO_BASE;
+
+    constexpr char32_t SYLLABLE_FIRST = 0xAC00;     // 가
+    constexpr char32_t SYLLABLE_LAST = 0xD7A3;      // 힣
+    constexpr int VOWELS_OF_SYLLABLES = 21;
+    constexpr int FINALS_OF_SYLLABLES = 28;         // The first one is 'no final'.
+    constexpr char32_t COMPAT_CONSONANT_FIRST = 0x3131;     // ㄱ
+    constexpr char32_t COMPAT_VOWEL_FIRST = 0x314F;         // ㅏ
+    constexpr char32_t COMPAT_VOWEL_LAST = 0x3163;          // ㅣ
+
+    // A byte that no alphabet takes, for the characters which are not letters
+    constexpr char NOT_A_LETTER = '\x7f';
+
+    // Consonant letters are 0 to 18 in the order of the initials; vowel letters follow from 19.
+    enum : unsigned char {
+        G, GG, N, D, DD, R, M, B, BB, S, SS, NG, J, JJ, CH, K, T, P, H,
+        A, YA, EO, YEO, O, YO, U, YU, EU, I
+    };
+    constexpr unsigned char NONE = 0xff;
+
+    // The letters of a jamo made of at most three of them, NONE after the last one
+    using Spelling = std::array<unsigned char, 3>;
+
+    // The vowels in the order of the syllables : ㅏ ㅐ ㅑ ㅒ ㅓ ㅔ ㅕ ㅖ ㅗ ㅘ ㅙ ㅚ ㅛ ㅜ ㅝ ㅞ ㅟ ㅠ ㅡ ㅢ ㅣ
+    constexpr std::array<Spelling, VOWELS_OF_SYLLABLES> VOWELS = {{
+            {A, NONE, NONE}, {A, I, NONE}, {YA, NONE, NONE}, {YA, I, NONE}, {EO, NONE, NONE}, {EO, I, NONE},
+            {YEO, NONE, NONE}, {YEO, I, NONE}, {O, NONE, NONE}, {O, A, NONE}, {O, A, I}, {O, I, NONE},
+            {YO, NONE, NONE}, {U, NONE, NONE}, {U, EO, NONE}, {U, EO, I}, {U, I, NONE}, {YU, NONE, NONE},
+            {EU, NONE, NONE}, {EU, I, NONE}, {I, NONE, NONE}
+    }};
+
+    // The finals in the order of the syllables, from 'no final'
+    constexpr std::array<Spelling, FINALS_OF_SYLLABLES> FINALS = {{
+            {NONE, NONE, NONE}, {G, NONE, NONE}, {GG, NONE, NONE}, {G, S, NONE}, {N, NONE, NONE}, {N, J, NONE},
+            {N, H, NONE}, {D, NONE, NONE}, {R, NONE, NONE}, {R, G, NONE}, {R, M, NONE}, {R, B, NONE},
+            {R, S, NONE}, {R, T, NONE}, {R, P, NONE}, {R, H, NONE}, {M, NONE, NONE}, {B, NONE, NONE},
+            {B, S, NONE}, {S, NONE, NONE}, {SS, NONE, NONE}, {NG, NONE, NONE}, {J, NONE, NONE}, {CH, NONE, NONE},
+            {K, NONE, NONE}, {T, NONE, NONE}, {P, NONE, NONE}, {H, NONE, NONE}
+    }};
+
+    // The consonant jamo ㄱ ㄲ ㄳ ... ㅎ from U+3131, which include the double finals
+    constexpr std::array<Spelling, 30> COMPAT_CONSONANTS = {{
+            {G, NONE, NONE}, {GG, NONE, NONE}, {G, S, NONE}, {N, NONE, NONE}, {N, J, NONE}, {N, H, NONE},
+            {D, NONE, NONE}, {DD, NONE, NONE}, {R, NONE, NONE}, {R, G, NONE}, {R, M, NONE}, {R, B, NONE},
+            {R, S, NONE}, {R, T, NONE}, {R, P, NONE}, {R, H, NONE}, {M, NONE, NONE}, {B, NONE, NONE},
+            {BB, NONE, NONE}, {B, S, NONE}, {S, NONE, NONE}, {SS, NONE, NONE}, {NG, NONE, NONE}, {J, NONE, NONE},
+            {JJ, NONE, NONE}, {CH, NONE, NONE}, {K, NONE, NONE}, {T, NONE, NONE}, {P, NONE, NONE}, {H, NONE, NONE}
+    }};
+
+    // The jamo of each consonant letter standing alone
+    constexpr std::array<char32_t, CONSONANT_NUM> LONE_CONSONANTS = {
+            0x3131, 0x3132, 0x3134, 0x3137, 0x3138, 0x3139, 0x3141, 0x3142, 0x3143, 0x3145,
+            0x3146, 0x3147, 0x3148, 0x3149, 0x314A, 0x314B, 0x314C, 0x314D, 0x314E
+    };
+
+    void put_spelling(std::string& letters, const Spelling& spelling) {
+        for (unsigned char letter : spelling) {
+            if (letter != NONE) {
+                letters += static_cast<char>(JAMO_BASE + letter);
+            }
+        }
+    }
+
+    void put_utf8(std::string& text, char32_t cp) {
+        if (cp < 0x80) {
+            text += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            text += static_cast<char>(0xC0 | cp >> 6);
+            text += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            text += static_cast<char>(0xE0 | cp >> 12);
+            text += static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+            text += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    // The code point at text[i], moving i past it; -1 for a byte which does not start a valid UTF-8 sequence of 1 to 3 bytes.
+    char32_t next_code_point(std::string_view text, std::size_t& i) {
+        const auto lead = static_cast<unsigned char>(text[i++]);
+        int more;
+        char32_t cp;
+        if (lead < 0x80) {
+            return lead;
+        } else if ((lead & 0xE0) == 0xC0) {
+            more = 1, cp = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            more = 2, cp = lead & 0x0F;
+        } else {
+            return static_cast<char32_t>(-1);
+        }
+        for (; more > 0; --more) {
+            if (i >= text.size() || (static_cast<unsigned char>(text[i]) & 0xC0) != 0x80) {
+                return static_cast<char32_t>(-1);
+            }
+            cp = cp << 6 | (static_cast<unsigned char>(text[i++]) & 0x3F);
+        }
+        return cp;
+    }
+
+    // The letter at letters[i] as a consonant (0 to 18) or a vowel (19 to 28), or NONE if it is not a jamo.
+    unsigned char jamo_at(std::string_view letters, std::size_t i) {
+        if (i >= letters.size()) {
+            return NONE;
+        }
+        const auto u = static_cast<unsigned char>(letters[i]);
+        return JAMO_BASE <= u && u < JAMO_BASE + CONSONANT_NUM + VOWEL_NUM ? u - JAMO_BASE : NONE;
+    }
+    bool is_consonant(unsigned char jamo) { return jamo < CONSONANT_NUM; }
+    bool is_vowel(unsigned char jamo) { return jamo != NONE && jamo >= CONSONANT_NUM; }
+
+    // The index in 'table' of the longest spelling that letters[i, ...) starts with, from 'first'; -1 if none does.
+    template<std::size_t N>
+    int longest_spelling(const std::array<Spelling, N>& table, std::size_t first, std::string_view letters,
+                         std::size_t i, std::size_t max_length, std::size_t& length) {
+        int best = -1;
+        length = 0;
+        for (std::size_t k = first; k < N; ++k) {
+            std::size_t l = 0;
+            while (l < 3 && table[k][l] != NONE && l < max_length && jamo_at(letters, i + l) == table[k][l]) {
+                ++l;
+            }
+            if ((l == 3 || table[k][l] == NONE) && l > length) {
+                best = static_cast<int>(k);
+                length = l;
+            }
+        }
+        return best;
+    }
+
+}
+
+std::string hangul::to_letters(std::string_view utf8) {
+    std::string letters;
+    letters.reserve(utf8.size());
+    for (std::size_t i = 0; i < utf8.size(); ) {
+        const char32_t cp = next_code_point(utf8, i);
+        if (cp < 0x80) {
+            letters += static_cast<char>(cp);
+        } else if (SYLLABLE_FIRST <= cp && cp <= SYLLABLE_LAST) {
+            const char32_t s = cp - SYLLABLE_FIRST;
+            letters += static_cast<char>(JAMO_BASE + s / (VOWELS_OF_SYLLABLES * FINALS_OF_SYLLABLES));
+            put_spelling(letters, VOWELS[s / FINALS_OF_SYLLABLES % VOWELS_OF_SYLLABLES]);
+            put_spelling(letters, FINALS[s % FINALS_OF_SYLLABLES]);
+        } else if (COMPAT_CONSONANT_FIRST <= cp && cp < COMPAT_VOWEL_FIRST) {
+            put_spelling(letters, COMPAT_CONSONANTS[cp - COMPAT_CONSONANT_FIRST]);
+        } else if (COMPAT_VOWEL_FIRST <= cp && cp <= COMPAT_VOWEL_LAST) {
+            put_spelling(letters, VOWELS[cp - COMPAT_VOWEL_FIRST]);
+        } else {
+            letters += NOT_A_LETTER;
+        }
+    }
+    return letters;
+}
+
+std::size_t hangul::length_at(std::string_view utf8, std::size_t pos) {
+    std::size_t next = pos;
+    const char32_t cp = next_code_point(utf8, next);
+    const bool is_hangul = (SYLLABLE_FIRST <= cp && cp <= SYLLABLE_LAST)
+                           || (COMPAT_CONSONANT_FIRST <= cp && cp <= COMPAT_VOWEL_LAST);
+    return is_hangul ? next - pos : 0;
+}
+
+std::string hangul::from_letters(std::string_view letters) {
+    std::string text;
+    text.reserve(letters.size() * 2);
+    for (std::size_t i = 0; i < letters.size(); ) {
+        const unsigned char jamo = jamo_at(letters, i);
+        if (jamo == NONE) {
+            text += letters[i++];
+            continue;
+        }
+
+        // A syllable : a consonant, then a vowel.
+        std::size_t vowel_length = 0;
+        const int vowel = is_consonant(jamo) && is_vowel(jamo_at(letters, i + 1))
+                          ? longest_spelling(VOWELS, 0, letters, i + 1, 3, vowel_length) : -1;
+        if (vowel == -1) {
+            // A jamo on its own
+            if (is_consonant(jamo)) {
+                put_utf8(text, LONE_CONSONANTS[jamo]);
+                ++i;
+            } else {
+                std::size_t length;
+                const int alone = longest_spelling(VOWELS, 0, letters, i, 3, length);
+                put_utf8(text, COMPAT_VOWEL_FIRST + alone);
+                i += length;
+            }
+            continue;
+        }
+
+        // The consonants after the vowel are its final, but for the last one if a vowel comes after them,
+        // since that one is the initial of the next syllable.
+        std::size_t next = i + 1 + vowel_length;
+        std::size_t consonants = 0;
+        while (is_consonant(jamo_at(letters, next + consonants))) {
+            ++consonants;
+        }
+        if (consonants > 0 && is_vowel(jamo_at(letters, next + consonants))) {
+            --consonants;
+        }
+        std::size_t final_length = 0;
+        const int final_jamo = consonants == 0 ? 0 : longest_spelling(FINALS, 1, letters, next, consonants, final_length);
+
+        put_utf8(text, SYLLABLE_FIRST + (jamo * VOWELS_OF_SYLLABLES + vowel) * FINALS_OF_SYLLABLES
+                       + std::max(final_jamo, 0));
+        i = next + final_length;
+    }
+    return text;
+}
+
+std::vector<std::string> HangulTrie::sorted_letters(const std::vector<std::string> &words) {
+    std::vector<std::string> letters;
+    letters.reserve(words.size());
+    for (const auto& word : words) {
+        letters.push_back(hangul::to_letters(word));
+    }
+    // Strings compare their bytes as unsigned, which is the order of the letters : 'a' to 'z', then the jamo.
+    std::sort(letters.begin(), letters.end());
+    return letters;
+}
+
+std::vector<std::string> HangulTrie::from_letters(const std::vector<std::string> &words) {
+    std::vector<std::string> ret;
+    ret.reserve(words.size());
+    for (const auto& word : words) {
+        ret.push_back(hangul::from_letters(word));
+    }
+    return ret;
+}
+
+HangulTrie::HangulTrie(const std::vector<std::string> &words) : trie(sorted_letters(words)) {}
+
+bool HangulTrie::_contains_(const std::string &input) const {
+    return trie._contains_(hangul::to_letters(input));
+}
+
+void HangulTrie::push(const std::string &input, const uint32_t weight) {
+    trie.push(hangul::to_letters(input), weight);
+}
+
+void HangulTrie::remove(const std::string &str) {
+    trie.remove(hangul::to_letters(str));
+}
+
+std::vector<std::string> HangulTrie::get_suggestions(const std::string &input, const int MAX_SUGGESTIONS) const {
+    return from_letters(trie.get_suggestions(hangul::to_letters(input), MAX_SUGGESTIONS));
+}
+
+std::vector<std::string> HangulTrie::get_top_suggestions(const std::string &input, const int MAX_SUGGESTIONS) const {
+    return from_letters(trie.get_top_suggestions(hangul::to_letters(input), MAX_SUGGESTIONS));
+}
+
+std::vector<std::string> HangulTrie::get_suggestions_within(const std::string &input, const int max_distance,
+                                                            const int MAX_SUGGESTIONS) const {
+    return from_letters(trie.get_suggestions_within(hangul::to_letters(input), max_distance, MAX_SUGGESTIONS));
+}
+
+std::vector<std::string> HangulTrie::traverse(const int MAX_VEC_SIZE) const {
+    return from_letters(trie.traverse(MAX_VEC_SIZE));
+}
+
+std::size_t HangulTrie::node_num() const {
+    return trie.node_num();
+}
+
+std::size_t HangulTrie::memory_usage() const {
+    return trie.memory_usage();
+}
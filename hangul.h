@@ -0,0 +1,100 @@
+#ifndef OOPFINAL_HANGUL_H
+#define OOPFINAL_HANGUL_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "trie.h"
+
+/*
+ A Trie cannot have a letter for every Hangul syllable : there are 11,172 of them, and a node has at most 64 children.
+ But every syllable is made of jamo : an initial consonant, a vowel and an optional final consonant, i.e. 한 = ㅎ + ㅏ + ㄴ.
+ So a Korean word is stored as its jamo, one letter each, and the Trie never sees a syllable :
+    한국 -> ㅎ ㅏ ㄴ ㄱ ㅜ ㄱ
+ Only 29 jamo are letters of their own : the 19 consonants which may start a syllable (ㄲ, ㄸ, ㅃ, ㅆ and ㅉ included),
+ and the 10 basic vowels ㅏ ㅑ ㅓ ㅕ ㅗ ㅛ ㅜ ㅠ ㅡ ㅣ. The other jamo are written with these :
+    vowels      ㅐ = ㅏㅣ, ㅔ = ㅓㅣ, ㅒ = ㅑㅣ, ㅖ = ㅕㅣ, ㅘ = ㅗㅏ, ㅙ = ㅗㅏㅣ, ㅚ = ㅗㅣ, ㅝ = ㅜㅓ, ㅞ = ㅜㅓㅣ, ㅟ = ㅜㅣ, ㅢ = ㅡㅣ
+    finals      ㄳ = ㄱㅅ, ㄵ = ㄴㅈ, ㄶ = ㄴㅎ, ㄺ = ㄹㄱ, ㄻ = ㄹㅁ, ㄼ = ㄹㅂ, ㄽ = ㄹㅅ, ㄾ = ㄹㅌ, ㄿ = ㄹㅍ, ㅀ = ㄹㅎ, ㅄ = ㅂㅅ
+ The letters spell a word back in one way only : every syllable starts with a consonant (ㅇ for a silent one), so a run of
+ vowels is one vowel, the consonant right before it is its initial, and the consonants between it and the previous vowel
+ are the final of the previous syllable. This is also why ㄲ and the other double consonants are letters of their own :
+ with ㄲ = ㄱㄱ, 각까 and 갂가 would be the same letters.
+
+ In the Trie, a letter is one byte : 'a' to 'z' as they are, and the jamo from JAMO_BASE on, in the order
+ ㄱ ㄲ ㄴ ㄷ ㄸ ㄹ ㅁ ㅂ ㅃ ㅅ ㅆ ㅇ ㅈ ㅉ ㅊ ㅋ ㅌ ㅍ ㅎ ㅏ ㅑ ㅓ ㅕ ㅗ ㅛ ㅜ ㅠ ㅡ ㅣ.
+ The consonants come first in the order of the initials, and the vowels in the order of the syllables, so
+ words are listed mostly as in a Korean dictionary; a shorter syllable comes first, i.e. 각 before 가가.
+ */
+namespace hangul {
+
+    constexpr int CONSONANT_NUM = 19;
+    constexpr int VOWEL_NUM = 10;
+    constexpr unsigned char JAMO_BASE = 0x80;
+
+    // The letters of a UTF-8 text : a syllable or a jamo (ㄱ, ㅏ, ...) is turned into its jamo as above, and
+    // 'a' to 'z' are kept. Any other character becomes a byte which is not a letter, so a word holding one is not found.
+    [[nodiscard]] std::string to_letters(std::string_view utf8);
+    // The UTF-8 text of the letters, the inverse of to_letters. Jamo making no syllable, such as the last ㄱ of
+    // ㅎㅏㄴㄱ (a prefix of 한국), are written as single jamo : 한ㄱ.
+    [[nodiscard]] std::string from_letters(std::string_view letters);
+    // The number of bytes of the Hangul syllable or jamo starting at utf8[pos], or 0 if none starts there.
+    [[nodiscard]] std::size_t length_at(std::string_view utf8, std::size_t pos);
+
+}
+
+// 'a' to 'z' and the 29 jamo of hangul.h, 55 letters in all
+struct HangulAscii {
+    static constexpr int SIZE = 26 + hangul::CONSONANT_NUM + hangul::VOWEL_NUM;
+    static constexpr int index(char c) {
+        const auto u = static_cast<unsigned char>(c);
+        if (97 <= u && u <= 122) {  // 97 == 'a', 122 == 'z'
+            return u - 97;
+        }
+        if (hangul::JAMO_BASE <= u && u < hangul::JAMO_BASE + hangul::CONSONANT_NUM + hangul::VOWEL_NUM) {
+            return 26 + (u - hangul::JAMO_BASE);
+        }
+        return -1;
+    }
+};
+
+using JamoTrie = BasicTrie<HangulAscii, Identity>;
+
+class HangulTrie {
+    /*
+     "HangulTrie" is a Trie for Korean words, and for words mixing Hangul with 'a' to 'z' : it takes and returns UTF-8,
+     and keeps the jamo of the words in a JamoTrie. Since a jamo is one letter of a 55-letter alphabet, a node is the same
+     24 bytes as in a Trie, and a lookup walks one node per jamo, about 2.5 per syllable.
+     Suggestions are found on the jamo too, so a word sharing the first consonant of a syllable shares a path, and
+     an edit distance of 1 is one wrong jamo, the usual typo on a Korean keyboard.
+     */
+    JamoTrie trie;
+
+    // The letters of the words, sorted so that the Trie is built in one pass (See BasicTrie::bulk_build.)
+    [[nodiscard]] static std::vector<std::string> sorted_letters(const std::vector<std::string>& words);
+    // The words of the Trie, spelled back in UTF-8
+    [[nodiscard]] static std::vector<std::string> from_letters(const std::vector<std::string>& words);
+
+public:
+    HangulTrie() = default;
+    explicit HangulTrie(const std::vector<std::string>& words);
+
+    [[nodiscard]] bool _contains_(const std::string& input) const;
+    void push(const std::string& input, uint32_t weight = 0);
+    void remove(const std::string& str);
+
+    // Same as Trie::get_suggestions, the common prefix being counted in jamo
+    [[nodiscard]] std::vector<std::string> get_suggestions(const std::string& input, int MAX_SUGGESTIONS) const;
+    // Same as Trie::get_top_suggestions
+    [[nodiscard]] std::vector<std::string> get_top_suggestions(const std::string& input, int MAX_SUGGESTIONS) const;
+    // Same as Trie::get_suggestions_within, with the edits counted in jamo
+    [[nodiscard]] std::vector<std::string> get_suggestions_within(const std::string& input, int max_distance,
+                                                                  int MAX_SUGGESTIONS) const;
+    [[nodiscard]] std::vector<std::string> traverse(int MAX_VEC_SIZE) const;
+
+    [[nodiscard]] std::size_t node_num() const;
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+#endif //OOPFINAL_HANGUL_H
@@ -572,12 +572,15 @@ std::string StringHolder::to_txt_data() const {
     return ret;
 }
 
-std::vector<std::pair<std::string, int>> StringHolder::data_split() const {
+std::vector<std::pair<std::string, int>> StringHolder::data_split(const bool with_hangul) const {
     std::vector<std::pair<std::string, int>> vecpair;
     vecpair.emplace_back("", 0);
 
     for (int i = 0; i < data.size(); ++i) {
-        if (65 <= data[i] && data[i] <= 90) {
+        if (const std::size_t length = with_hangul ? hangul::length_at(data, i) : 0; length > 0) {
+            vecpair.back().first.append(data, i, length);
+            i += (int) length - 1;
+        } else if (65 <= data[i] && data[i] <= 90) {
             vecpair.back().first += data[i] + 32;
         } else if (97 <= data[i] && data[i] <= 122) {
             vecpair.back().first += data[i];
@@ -624,8 +627,50 @@ void StringHolder::push(const std::string &str) {
     data += str;
 }
 
-void StringHolder::spellcheck(const Trie &trie1, const Trie &trie2, const int MAX_SUGGESTIONS) {
-    std::vector<std::pair<std::string, int>> vecpair = data_split();
+std::vector<AhoCorasick::Match> StringHolder::find_all(const AhoCorasick &patterns) const {
+    return patterns.find_all(data);
+}
+
+int StringHolder::replace_all(const AhoCorasick &patterns, const std::vector<std::string> &replacements) {
+    const std::vector<AhoCorasick::Match> matches = patterns.find_leftmost_longest(data);
+    if (!matches.empty()) {
+        data = patterns.replace_matches(data, matches, replacements);
+    }
+    return (int) matches.size();
+}
+
+std::vector<std::string> StringHolder::suggest_by_closeness(const Lexicon &dict, const std::string &str,
+                                                        const int MAX_SUGGESTIONS) {
+    // The best words over the whole dictionary, by the length of the common prefix plus that of the common suffix
+    return dict.get_suggestions_by_closeness(str, MAX_SUGGESTIONS);
+}
+
+std::string StringHolder::split_into_words(const Lexicon &dict, const std::string &str) {
+    const std::vector<std::string_view> words = dict.segment(str);
+    std::string ret;
+    if (words.size() < 2) {
+        return ret;
+    }
+    for (const auto& word : words) {
+        if (!ret.empty()) {
+            ret += ' ';
+        }
+        ret += word;
+    }
+    return ret;
+}
+
+template<typename ContainsMany, typename Suggest>
+void StringHolder::correct_misspellings(const ContainsMany &contains_many, const Suggest &suggest, const bool with_hangul) {
+    std::vector<std::pair<std::string, int>> vecpair = data_split(with_hangul);
+
+    // Check every word in one batch before asking anything; only the misspelled ones need suggestions.
+    std::vector<std::string> lowercase_words;
+    lowercase_words.reserve(vecpair.size());
+    for (const auto& pairpair : vecpair) {
+        lowercase_words.push_back(mints::make_lowercase(pairpair.first));
+    }
+    const std::vector<bool> is_correct = contains_many(lowercase_words);
 
     // If the length of data is modified by our spell-check operation, then our mlsf variable will revise it
     int modified_length_so_far = 0;
@@ -633,41 +678,22 @@ void StringHolder::spellcheck(const Trie &trie1, const Trie &trie2, const int MA
 
     unsigned int idx = -1;
 
-    for (const auto& pairpair : vecpair) {
-        std::string str = mints::make_lowercase(pairpair.first);
-        if (trie1._contains_(str)) {
+    for (int i = 0; i < vecpair.size(); ++i) {
+        const auto& pairpair = vecpair[i];
+        const std::string& str = lowercase_words[i];
+        if (is_correct[i]) {
             // If our letter is in out trie, i.e. right spell, then just pass
             continue;
         }
-        // Get our suggests list in our Trie
-        std::vector<std::string> suggests = trie1.get_suggestions(str, MAX_SUGGESTIONS * 20);
-        std::vector<std::string> hold = trie2.get_suggestions(str, MAX_SUGGESTIONS * 20);
-        suggests.insert(suggests.end(), hold.begin(), hold.end());
-
-        // Sort in increasing order of closeness
-        // Since sorting the strings directly causes a lot of memory allocations, we rather sort the pointer of strings, not strings
-        std::string* ptrs[suggests.size()];
-        for (int i = 0; i < suggests.size(); ++i) {
-            ptrs[i] = &suggests[i];
-        }
-
-        const std::function<std::string(const std::string&)> read_dir_1 = trie1.get_preprocess();
-        const std::function<std::string(const std::string&)> read_dir_2 = trie2.get_preprocess();
-
-        // The lambda function in the 3rd component of 'sort' is a function that reads two string pointers (lhs, rhs) and return whether *lhs is closer to 'str' than *rhs.
-        std::sort(ptrs, ptrs + suggests.size(),
-                  [str, &read_dir_1, &read_dir_2](std::string* lhs, std::string* rhs) -> bool {
-                      return mints::closeness(*lhs, str, read_dir_1) + mints::closeness(*lhs, str, read_dir_2) > mints::closeness(*rhs, str, read_dir_1) + mints::closeness(*rhs, str, read_dir_2);
-                  });
 
-        // If MAX_SUGGESTIONS = 20 and suggests.size() = 15, then we suggest 15 words
-        // If MAX_SUGGESTIONS = 20 and suggests.size() = 40, then we suggest 20 words
-        const int final_recommending_number = suggests.size() < MAX_SUGGESTIONS ? (int) suggests.size() : MAX_SUGGESTIONS;
+        // The suggestions are already sorted, the best first, and there are at most MAX_SUGGESTIONS of them.
+        const std::vector<std::string> suggests = suggest(str);
+        const int final_recommending_number = (int) suggests.size();
 
         // Print our alternative words
         std::cout << "The alternative words for word '" << str << "' are: " << std::endl;
         for (int i = 0; i < final_recommending_number; ++i) {
-            std::cout << i + 1 << " " << *ptrs[i] << " | ";
+            std::cout << i + 1 << " " << suggests[i] << " | ";
         } std::cout << std::endl;
 
         // Asks users that do you want to correct it
@@ -682,10 +708,10 @@ void StringHolder::spellcheck(const Trie &trie1, const Trie &trie2, const int MA
             continue;
         } else {
             remove(pairpair.second + mlsf, (unsigned int) pairpair.first.size());
-            insert(pairpair.second + mlsf, *ptrs[idx]);
+            insert(pairpair.second + mlsf, suggests[idx]);
 
             // mlsf -= size to delete; mlsf += size to put;
-            mlsf -= (unsigned int) pairpair.first.size() - ptrs[idx]->size();
+            mlsf -= (unsigned int) pairpair.first.size() - suggests[idx].size();
 
             print();
         }
@@ -697,3 +723,131 @@ void StringHolder::spellcheck(const Trie &trie1, const Trie &trie2, const int MA
     std::cout << "END OF SPELL-CHECK" << std::endl << std::endl;
 
 }
+
+void StringHolder::spellcheck(const Lexicon &dict, const int MAX_SUGGESTIONS, const SPELLCHECK_MODE mode) {
+    correct_misspellings(
+            [&dict](const std::vector<std::string>& words) {
+                return dict.contains_many(words);
+            },
+            [&dict, MAX_SUGGESTIONS, mode](const std::string& str) {
+                std::vector<std::string> suggests = mode == BY_EDIT_DISTANCE
+                        ? dict.get_suggestions_within(str, MAX_EDIT_DISTANCE, MAX_SUGGESTIONS)
+                        : suggest_by_closeness(dict, str, MAX_SUGGESTIONS);
+                // A word made of several words which lost their spaces is best fixed by splitting it, so that comes first.
+                std::string split = split_into_words(dict, str);
+                if (!split.empty()) {
+                    suggests.insert(suggests.begin(), std::move(split));
+                    if (suggests.size() > MAX_SUGGESTIONS) {
+                        suggests.pop_back();
+                    }
+                }
+                return suggests;
+            });
+}
+
+void StringHolder::spellcheck(const SymSpellIndex &index, const int MAX_SUGGESTIONS) {
+    correct_misspellings(
+            [&index](const std::vector<std::string>& words) {
+                std::vector<bool> found;
+                found.reserve(words.size());
+                for (const auto& word : words) {
+                    found.push_back(index._contains_(word));
+                }
+                return found;
+            },
+            [&index, MAX_SUGGESTIONS](const std::string& str) {
+                return index.get_suggestions(str, MAX_SUGGESTIONS);
+            });
+}
+
+void StringHolder::spellcheck(const ShardedDictionary &dict, const int MAX_SUGGESTIONS) {
+    correct_misspellings(
+            [&dict](const std::vector<std::string>& words) {
+                return dict.contains_many(words);
+            },
+            [&dict, MAX_SUGGESTIONS](const std::string& str) {
+                return dict.get_suggestions(str, MAX_SUGGESTIONS);
+            });
+}
+
+void StringHolder::spellcheck(const FrozenTrie &dict, const int MAX_SUGGESTIONS, const SPELLCHECK_MODE mode) {
+    correct_misspellings(
+            [&dict](const std::vector<std::string>& words) {
+                return dict.contains_many(words);
+            },
+            [&dict, MAX_SUGGESTIONS, mode](const std::string& str) {
+                return mode == BY_EDIT_DISTANCE ? dict.get_suggestions_within(str, MAX_EDIT_DISTANCE, MAX_SUGGESTIONS)
+                                                : dict.get_suggestions(str, MAX_SUGGESTIONS);
+            });
+}
+
+void StringHolder::spellcheck(const Dawg &dict, const int MAX_SUGGESTIONS, const SPELLCHECK_MODE mode) {
+    correct_misspellings(
+            [&dict](const std::vector<std::string>& words) {
+                std::vector<bool> found;
+                found.reserve(words.size());
+                for (const auto& word : words) {
+                    found.push_back(dict._contains_(word));
+                }
+                return found;
+            },
+            [&dict, MAX_SUGGESTIONS, mode](const std::string& str) {
+                return mode == BY_EDIT_DISTANCE ? dict.get_suggestions_within(str, MAX_EDIT_DISTANCE, MAX_SUGGESTIONS)
+                                                : dict.get_suggestions(str, MAX_SUGGESTIONS);
+            });
+}
+
+void StringHolder::spellcheck(const HangulTrie &dict, const int MAX_SUGGESTIONS, const SPELLCHECK_MODE mode) {
+    correct_misspellings(
+            [&dict](const std::vector<std::string>& words) {
+                std::vector<bool> found;
+                found.reserve(words.size());
+                for (const auto& word : words) {
+                    // Only Hangul takes bytes from 0x80 on in a word of data_split.
+                    const bool has_hangul = std::ranges::any_of(word, [](char c) { return c & 0x80; });
+                    found.push_back(!has_hangul || dict._contains_(word));
+                }
+                return found;
+            },
+            [&dict, MAX_SUGGESTIONS, mode](const std::string& str) {
+                return mode == BY_EDIT_DISTANCE ? dict.get_suggestions_within(str, MAX_EDIT_DISTANCE, MAX_SUGGESTIONS)
+                                                : dict.get_suggestions(str, MAX_SUGGESTIONS);
+            },
+            true);
+}
+
+int StringHolder::fix_spacing(const Lexicon &dict) {
+    // The places to put a space at, in the order of the data
+    std::vector<std::size_t> spaces;
+    int split_num = 0;
+    for (const auto& [word, start] : data_split()) {
+        const std::string lower = mints::make_lowercase(word);
+        if (dict._contains_(lower)) {
+            continue;
+        }
+        const std::vector<std::string_view> pieces = dict.segment(lower);
+        if (pieces.size() < 2) {
+            continue;
+        }
+        // The pieces are views into 'lower', whose letters are at the same places as those of the word in the data.
+        for (std::size_t i = 1; i < pieces.size(); ++i) {
+            spaces.push_back(start + (pieces[i].data() - lower.data()));
+        }
+        ++split_num;
+    }
+    if (spaces.empty()) {
+        return 0;
+    }
+
+    std::string fixed;
+    fixed.reserve(data.size() + spaces.size());
+    std::size_t copied = 0;
+    for (std::size_t pos : spaces) {
+        fixed.append(data, copied, pos - copied);
+        fixed += ' ';
+        copied = pos;
+    }
+    fixed.append(data, copied);
+    data = std::move(fixed);
+    return split_num;
+}
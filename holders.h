@@ -8,6 +8,13 @@
 
 #include "mint_utils.h"
 #include "trie.h"
+#include "frozen_trie.h"
+#include "dawg.h"
+#include "hangul.h"
+#include "lexicon.h"
+#include "symspell.h"
+#include "sharded_dict.h"
+#include "aho_corasick.h"
 
 class Holder {
 protected:
@@ -229,6 +236,11 @@ private:
 class StringHolder : public Holder {
     std::string data;
 public:
+    // How the spell-check finds the alternative words of a misspelled word
+    enum SPELLCHECK_MODE {BY_CLOSENESS, BY_EDIT_DISTANCE};
+    // The largest edit distance of the alternative words in BY_EDIT_DISTANCE mode
+    static constexpr int MAX_EDIT_DISTANCE = 2;
+
     explicit StringHolder(const std::vector<std::string>& _data);
     StringHolder();
 
@@ -243,7 +255,21 @@ public:
     [[nodiscard]] std::string to_txt_data() const override;
 
 private:
-    [[nodiscard]] std::vector<std::pair<std::string, int>> data_split() const;
+    // The words of the data, lowercased, with the places they start at; with_hangul counts Hangul as letters too.
+    [[nodiscard]] std::vector<std::pair<std::string, int>> data_split(bool with_hangul = false) const;
+
+    // The words of 'str' split by Lexicon::segment, joined with spaces; empty if it does not split into two words or more.
+    [[nodiscard]] static std::string split_into_words(const Lexicon& dict, const std::string& str);
+
+    // The words of the highest closeness to 'str' in the dictionary : the length of the common prefix plus that of the common suffix
+    [[nodiscard]] static std::vector<std::string> suggest_by_closeness(const Lexicon& dict, const std::string& str,
+                                                                       int MAX_SUGGESTIONS);
+
+    // The interactive part of every spell-check : every word is checked at once by 'contains_many' first,
+    // then for each word it rejects, show the words made by 'suggest' (best first) and replace the word with the one the user picks.
+    // with_hangul makes the words of Hangul as well (See data_split.)
+    template<typename ContainsMany, typename Suggest>
+    void correct_misspellings(const ContainsMany& contains_many, const Suggest& suggest, bool with_hangul = false);
 
 public:
     // Edit methods
@@ -260,8 +286,40 @@ public:
     // push : If data = "abc", and we apply push("defg"), then we get editted data = "abcdefg"
     void push(const std::string& str);
 
-    // Spell-check method 2 : Improved spell-check with 2 tries
-    void spellcheck(const Trie& trie1, const Trie& trie2, int MAX_SUGGESTIONS = 1000);
+    // Every occurrence of the patterns of 'patterns' in the data, in one pass (See AhoCorasick::find_all.)
+    [[nodiscard]] std::vector<AhoCorasick::Match> find_all(const AhoCorasick& patterns) const;
+
+    // replace_all : If data = "a cat and a dog", and we replace {"cat", "dog"} with {"dog", "cat"},
+    // then we get edited data = "a dog and a cat". The data is rebuilt once, however many words are replaced.
+    // Returns the number of words replaced.
+    int replace_all(const AhoCorasick& patterns, const std::vector<std::string>& replacements);
+
+    // Spell-check method 2 : spell-check with a Lexicon, which suggests the words sharing the longest prefix plus suffix
+    // with the misspelling (See Lexicon::get_suggestions_by_closeness), or in BY_EDIT_DISTANCE mode the words within
+    // MAX_EDIT_DISTANCE edits. A misspelling the Lexicon can split into words, such as "thecat", gets that split first.
+    void spellcheck(const Lexicon& dict, int MAX_SUGGESTIONS = 1000, SPELLCHECK_MODE mode = BY_CLOSENESS);
+
+    // Spell-check method 3 : spell-check with a symmetric-delete index, which suggests the words within its edit distance
+    void spellcheck(const SymSpellIndex& index, int MAX_SUGGESTIONS = 1000);
+
+    // Spell-check method 4 : spell-check with a ShardedDictionary, which suggests the words sharing the longest prefix
+    // with the misspelling (See ShardedDictionary::get_suggestions); only the shards the words of the data need are read.
+    void spellcheck(const ShardedDictionary& dict, int MAX_SUGGESTIONS = 1000);
+
+    // Spell-check method 5 : spell-check with a FrozenTrie, which suggests the words sharing the longest prefix,
+    // or in BY_EDIT_DISTANCE mode the words within MAX_EDIT_DISTANCE edits
+    void spellcheck(const FrozenTrie& dict, int MAX_SUGGESTIONS = 1000, SPELLCHECK_MODE mode = BY_CLOSENESS);
+
+    // Spell-check method 6 : same as method 5, with a Dawg, which shares the suffixes of the words as well
+    void spellcheck(const Dawg& dict, int MAX_SUGGESTIONS = 1000, SPELLCHECK_MODE mode = BY_CLOSENESS);
+
+    // Spell-check method 7 : same as method 5 for the words holding Hangul, with a HangulTrie; the prefixes and the edits
+    // are counted in jamo. The words of 'a' to 'z' alone are left to the other methods.
+    void spellcheck(const HangulTrie& dict, int MAX_SUGGESTIONS = 1000, SPELLCHECK_MODE mode = BY_CLOSENESS);
+
+    // Put spaces into every misspelled word that splits into words of the dictionary, i.e. "theprogramisclosed" into
+    // "the program is closed" (See Lexicon::segment.) The data is rebuilt once. Returns the number of words split.
+    int fix_spacing(const Lexicon& dict);
 
 };
 
@@ -0,0 +1,552 @@
+#include "lexicon.h"
+#include "trie.h"
+#include "edit_distance.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <ranges>
+#include <string>
+
+namespace {
+
+    /*
+     Compare the first 'length' letters of two words, both read in the order of the Transform.
+     Letters are compared as unsigned chars, like std::string does, so Identity gives the alphabetical order.
+     */
+    template<typename Transform>
+    int compare(std::string_view lhs, std::string_view rhs, std::size_t length = std::string_view::npos) {
+        const std::size_t lhs_len = std::min(lhs.size(), length), rhs_len = std::min(rhs.size(), length);
+        for (std::size_t i = 0; i < lhs_len && i < rhs_len; ++i) {
+            const auto a = static_cast<unsigned char>(Transform::at(lhs, i));
+            const auto b = static_cast<unsigned char>(Transform::at(rhs, i));
+            if (a != b) {
+                return a < b ? -1 : 1;
+            }
+        }
+        return lhs_len < rhs_len ? -1 : lhs_len > rhs_len ? 1 : 0;
+    }
+
+    // The number of leading letters two words share, in the order of the Transform
+    template<typename Transform>
+    std::size_t common_prefix_length(std::string_view lhs, std::string_view rhs) {
+        std::size_t len = 0;
+        while (len < lhs.size() && len < rhs.size() && Transform::at(lhs, len) == Transform::at(rhs, len)) {
+            ++len;
+        }
+        return len;
+    }
+
+    // Copies of the first 'count' words of a generator
+    std::vector<std::string> copy_first(mints::Generator<std::string_view> words, const int count) {
+        std::vector<std::string> ret;
+        for (std::string_view word : words) {
+            if (ret.size() >= count) {
+                break;
+            }
+            ret.emplace_back(word);
+        }
+        return ret;
+    }
+
+    // The first rank in [0, n) for which 'pred' is false; pred must be true for a prefix of the ranks only.
+    template<typename Pred>
+    uint32_t first_rank_not(std::size_t n, Pred pred) {
+        return *std::ranges::partition_point(std::views::iota(uint32_t{0}, static_cast<uint32_t>(n)), pred);
+    }
+
+}
+
+Lexicon::Lexicon(const std::vector<std::string> &words, const std::vector<uint32_t> &word_weights) : weights(nullptr) {
+    if (!word_weights.empty() && word_weights.size() != words.size()) {
+        throw mints::input_out_of_range("Every word needs a weight : {words : " + std::to_string(words.size())
+                                        + ", weights : " + std::to_string(word_weights.size()) + "}");
+    }
+
+    std::vector<std::pair<std::string, uint32_t>> sorted;
+    sorted.reserve(words.size());
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        const auto& word = words[i];
+        if (std::all_of(word.begin(), word.end(), [](char c) { return Ascii26::index(c) != -1; })) {
+            sorted.emplace_back(word, word_weights.empty() ? 0 : word_weights[i]);
+        }
+    }
+    // The heaviest copy of a word comes first, and is the one kept.
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first != rhs.first ? lhs.first < rhs.first : lhs.second > rhs.second;
+    });
+    sorted.erase(std::unique(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first == rhs.first;
+    }), sorted.end());
+
+    offsets_data.reserve(sorted.size() + 1);
+    for (const auto& [word, w] : sorted) {
+        offsets_data.push_back(static_cast<uint32_t>(pool_data.size()));
+        pool_data.insert(pool_data.end(), word.begin(), word.end());
+    }
+    offsets_data.push_back(static_cast<uint32_t>(pool_data.size()));
+
+    offsets = offsets_data.data();
+    pool = pool_data.data();
+    word_num = sorted.size();
+
+    if (std::any_of(sorted.begin(), sorted.end(), [](const auto& entry) { return entry.second != 0; })) {
+        weights_data.reserve(word_num);
+        for (const auto& entry : sorted) {
+            weights_data.push_back(entry.second);
+        }
+        weights = weights_data.data();
+    }
+
+    by_suffix_data.resize(word_num);
+    std::iota(by_suffix_data.begin(), by_suffix_data.end(), 0);
+    std::sort(by_suffix_data.begin(), by_suffix_data.end(), [this](uint32_t lhs, uint32_t rhs) {
+        return compare<Reversed>(word(lhs), word(rhs)) < 0;
+    });
+    by_suffix = by_suffix_data.data();
+
+    make_buckets();
+    make_weight_tree();
+}
+
+Lexicon::Lexicon(const uint32_t *_offsets, const uint32_t *_by_suffix, const char *_pool, std::size_t _word_num,
+                 const uint32_t *_weights)
+        : offsets(_offsets), by_suffix(_by_suffix), pool(_pool), weights(_weights), word_num(_word_num) {
+    make_buckets();
+    make_weight_tree();
+}
+
+int Lexicon::bucket_of(std::string_view word) {
+    int key = 0;
+    for (std::size_t i = 0; i < 2; ++i) {
+        int letter = -1;
+        if (i < word.size()) {
+            letter = Ascii26::index(word[i]);
+            if (letter == -1) {
+                return -1;
+            }
+        }
+        key = key * 27 + letter + 1;
+    }
+    return key;
+}
+
+void Lexicon::make_buckets() {
+    bucket_begin.resize(BUCKET_NUM + 1);
+    for (int key = 0; key <= BUCKET_NUM; ++key) {
+        bucket_begin[key] = first_rank_not(word_num, [&](uint32_t id) {
+            return bucket_of(word(id)) < key;
+        });
+    }
+}
+
+void Lexicon::make_weight_tree() {
+    if (weights == nullptr) {
+        return;
+    }
+    // A power of two leaves, so that every node covers one range of ids; the leaves past the words weigh 0.
+    weight_leaves = std::bit_ceil(std::max<std::size_t>(word_num, 1));
+    weight_tree.assign(2 * weight_leaves, 0);
+    std::copy(weights, weights + word_num, weight_tree.begin() + static_cast<std::ptrdiff_t>(weight_leaves));
+    for (std::size_t n = weight_leaves - 1; n >= 1; --n) {
+        weight_tree[n] = std::max(weight_tree[2 * n], weight_tree[2 * n + 1]);
+    }
+    weight_sum = std::accumulate(weights, weights + word_num, uint64_t{0});
+}
+
+Lexicon::State Lexicon::child_state(const State &state, const char c) const {
+    const int letter = Ascii26::index(c);
+    if (letter == -1 || state.begin >= state.end) {
+        return {state.begin, state.begin, state.depth + 1};
+    }
+    // The first two letters are those of the buckets, so their runs are read from bucket_begin without a search.
+    if (state.depth == 0) {
+        return {bucket_begin[27 * (letter + 1)], bucket_begin[27 * (letter + 2)], 1};
+    }
+    if (state.depth == 1) {
+        const int key = 27 * (Ascii26::index(pool[offsets[state.begin]]) + 1) + letter + 1;
+        return {bucket_begin[key], bucket_begin[key + 1], 2};
+    }
+
+    // A word too short to have a letter at 'depth' comes first.
+    auto letter_at = [&](uint32_t offset) -> int {
+        const uint32_t id = state.begin + offset;
+        return offsets[id + 1] - offsets[id] <= state.depth ? -1 : static_cast<unsigned char>(pool[offsets[id] + state.depth]);
+    };
+    const uint32_t begin = state.begin + first_rank_not(state.end - state.begin, [&](uint32_t offset) {
+        return letter_at(offset) < static_cast<unsigned char>(c);
+    });
+    const uint32_t end = begin + first_rank_not(state.end - begin, [&](uint32_t offset) {
+        return letter_at(begin - state.begin + offset) <= static_cast<unsigned char>(c);
+    });
+    return {begin, end, state.depth + 1};
+}
+
+template<typename Transform>
+uint32_t Lexicon::id_at(uint32_t rank) const {
+    if constexpr (std::is_same_v<Transform, Reversed>) {
+        return by_suffix[rank];
+    } else {
+        return rank;
+    }
+}
+
+template<typename Transform>
+std::pair<uint32_t, uint32_t> Lexicon::closest_run(std::string_view input) const {
+    auto word_at = [this](uint32_t rank) {
+        return word(id_at<Transform>(rank));
+    };
+
+    // The longest prefix the input shares with any word is shared with a neighbour of the place where the input would go.
+    const uint32_t pos = first_rank_not(word_num, [&](uint32_t rank) {
+        return compare<Transform>(word_at(rank), input) < 0;
+    });
+    std::size_t shared = 0;
+    if (pos > 0) {
+        shared = common_prefix_length<Transform>(word_at(pos - 1), input);
+    }
+    if (pos < word_num) {
+        shared = std::max(shared, common_prefix_length<Transform>(word_at(pos), input));
+    }
+
+    // The run of the words starting with those 'shared' letters
+    const uint32_t begin = first_rank_not(word_num, [&](uint32_t rank) {
+        return compare<Transform>(word_at(rank), input, shared) < 0;
+    });
+    const uint32_t end = first_rank_not(word_num, [&](uint32_t rank) {
+        return compare<Transform>(word_at(rank), input, shared) <= 0;
+    });
+
+    return {begin, end};
+}
+
+template<typename Transform>
+mints::Generator<std::string_view> Lexicon::closest(std::string input) const {
+    const auto [begin, end] = closest_run<Transform>(input);
+    for (uint32_t rank = begin; rank < end; ++rank) {
+        co_yield word(id_at<Transform>(rank));
+    }
+}
+
+template<typename Transform>
+std::vector<std::pair<uint32_t, uint32_t>> Lexicon::nested_runs(std::string_view input) const {
+    std::vector<std::pair<uint32_t, uint32_t>> runs{{0, static_cast<uint32_t>(word_num)}};
+    for (std::size_t length = 1; length <= input.size(); ++length) {
+        // Each run is found by binary search inside the previous one, whose words all share the letters before the last;
+        // so only the last letter is compared, a word too short to have it coming first.
+        const auto [outer_begin, outer_end] = runs.back();
+        const auto letter = static_cast<unsigned char>(Transform::at(input, length - 1));
+        auto letter_at = [&](uint32_t offset) -> int {
+            const std::string_view w = word(id_at<Transform>(outer_begin + offset));
+            return w.size() < length ? -1 : static_cast<unsigned char>(Transform::at(w, length - 1));
+        };
+        const uint32_t begin = outer_begin + first_rank_not(outer_end - outer_begin, [&](uint32_t offset) {
+            return letter_at(offset) < letter;
+        });
+        const uint32_t end = outer_begin + first_rank_not(outer_end - outer_begin, [&](uint32_t offset) {
+            return letter_at(offset) <= letter;
+        });
+        if (begin == end) {
+            break;
+        }
+        runs.emplace_back(begin, end);
+    }
+    return runs;
+}
+
+std::string_view Lexicon::word(uint32_t id) const {
+    return {pool + offsets[id], offsets[id + 1] - offsets[id]};
+}
+
+uint32_t Lexicon::weight(uint32_t id) const {
+    return weights == nullptr ? 0 : weights[id];
+}
+
+bool Lexicon::has_weights() const {
+    return weights != nullptr;
+}
+
+void Lexicon::fill_filter(BloomFilter empty) {
+    filter = std::move(empty);
+    for (uint32_t id = 0; id < word_num; ++id) {
+        filter->insert(word(id));
+    }
+}
+
+void Lexicon::build_filter(double false_positive_rate) {
+    fill_filter(BloomFilter::for_false_positive_rate(word_num, false_positive_rate));
+}
+
+void Lexicon::build_filter_within(std::size_t max_bytes) {
+    fill_filter(BloomFilter::for_memory(max_bytes));
+}
+
+void Lexicon::drop_filter() {
+    filter.reset();
+}
+
+const BloomFilter *Lexicon::get_filter() const {
+    return filter ? &*filter : nullptr;
+}
+
+bool Lexicon::_contains_(std::string_view input) const {
+    const int key = bucket_of(input);
+    if (key == -1 || (filter && !filter->may_contain(input))) {
+        return false;
+    }
+    const uint32_t begin = bucket_begin[key];
+    const uint32_t pos = begin + first_rank_not(bucket_begin[key + 1] - begin, [&](uint32_t rank) {
+        return word(begin + rank) < input;
+    });
+    return pos < bucket_begin[key + 1] && word(pos) == input;
+}
+
+std::vector<bool> Lexicon::contains_many(std::span<const std::string> inputs) const {
+    std::vector<bool> found(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        found[i] = _contains_(inputs[i]);
+    }
+    return found;
+}
+
+std::vector<std::string> Lexicon::get_suggestions_by_prefix(const std::string &input, const int MAX_SUGGESTIONS) const {
+    return copy_first(suggestions_by_prefix(input), MAX_SUGGESTIONS);
+}
+
+std::vector<std::string> Lexicon::get_suggestions_by_suffix(const std::string &input, const int MAX_SUGGESTIONS) const {
+    return copy_first(suggestions_by_suffix(input), MAX_SUGGESTIONS);
+}
+
+mints::Generator<std::string_view> Lexicon::suggestions_by_prefix(std::string input) const {
+    return closest<Identity>(std::move(input));
+}
+
+mints::Generator<std::string_view> Lexicon::suggestions_by_suffix(std::string input) const {
+    return closest<Reversed>(std::move(input));
+}
+
+std::vector<std::string> Lexicon::get_suggestions_within(const std::string &input, const int max_distance,
+                                                         const int MAX_SUGGESTIONS) const {
+    std::vector<std::string> ret;
+    for (auto& [word, distance] : mints::search_within_distance(*this, input, max_distance)) {
+        if (ret.size() >= MAX_SUGGESTIONS) {
+            break;
+        }
+        ret.push_back(std::move(word));
+    }
+    return ret;
+}
+
+std::vector<std::string> Lexicon::get_top_suggestions(const std::string &input, const int MAX_SUGGESTIONS) const {
+    const auto [begin, end] = closest_run<Identity>(input);
+    std::vector<std::string> ret;
+    if (weights == nullptr) {
+        for (uint32_t id = begin; id < end && ret.size() < MAX_SUGGESTIONS; ++id) {
+            ret.emplace_back(word(id));
+        }
+        return ret;
+    }
+
+    // The first id a node covers, to take the alphabetically smaller words first among equal weights
+    auto first_id = [this](std::size_t node) {
+        while (node < weight_leaves) {
+            node *= 2;
+        }
+        return node - weight_leaves;
+    };
+    auto lighter = [&](std::size_t lhs, std::size_t rhs) {
+        if (weight_tree[lhs] != weight_tree[rhs]) {
+            return weight_tree[lhs] < weight_tree[rhs];
+        }
+        return first_id(lhs) > first_id(rhs);
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(lighter)> heap(lighter);
+
+    // The nodes covering exactly [begin, end), found from the leaves up; every node below them lies in the run too.
+    for (std::size_t lo = begin + weight_leaves, hi = end + weight_leaves; lo < hi; lo /= 2, hi /= 2) {
+        if (lo & 1) {
+            heap.push(lo++);
+        }
+        if (hi & 1) {
+            heap.push(--hi);
+        }
+    }
+
+    // A leaf comes out only when no node left in the heap holds a heavier word.
+    while (!heap.empty() && ret.size() < MAX_SUGGESTIONS) {
+        const std::size_t node = heap.top();
+        heap.pop();
+        if (node >= weight_leaves) {
+            ret.emplace_back(word(static_cast<uint32_t>(node - weight_leaves)));
+        } else {
+            heap.push(2 * node);
+            heap.push(2 * node + 1);
+        }
+    }
+    return ret;
+}
+
+std::vector<std::string> Lexicon::get_suggestions_by_closeness(const std::string &input, const int MAX_SUGGESTIONS) const {
+    /*
+     A word of closeness p + s shares exactly p letters at the front and s letters at the back with the input.
+     The words sharing exactly p letters at the front are a "prefix level" : runs[p] without runs[p + 1] in the
+     alphabetical order. So are the "suffix levels" in the order of by_suffix.
+     We read whole levels from the deepest ones down, on either side, and keep the best words in a bounded heap.
+     Once the prefix levels above p and the suffix levels above s are read, every word not yet read shares at most
+     p letters at the front and s at the back; so when the heap is full of words of closeness above p + s,
+     nothing left can enter it and the search stops. A word of closeness p + s may still beat the worst word kept
+     by its weight or its place in the alphabet, so the levels are read on while the worst word kept has just p + s.
+     Usually it stops long before the short levels at the top, which hold most of the dictionary.
+     */
+    if (MAX_SUGGESTIONS <= 0) {
+        return {};
+    }
+    const auto prefix_runs = nested_runs<Identity>(input);
+    const auto suffix_runs = nested_runs<Reversed>(input);
+    // The deepest level not read yet on each side
+    int next_prefix = static_cast<int>(prefix_runs.size()) - 1;
+    int next_suffix = static_cast<int>(suffix_runs.size()) - 1;
+
+    struct Scored {
+        uint32_t    closeness, id;
+    };
+    auto better = [this](const Scored& lhs, const Scored& rhs) {
+        if (lhs.closeness != rhs.closeness) {
+            return lhs.closeness > rhs.closeness;
+        }
+        const uint32_t lhs_weight = weight(lhs.id), rhs_weight = weight(rhs.id);
+        return lhs_weight != rhs_weight ? lhs_weight > rhs_weight : lhs.id < rhs.id;
+    };
+    // The top is the worst word kept.
+    std::priority_queue<Scored, std::vector<Scored>, decltype(better)> best(better);
+    auto offer = [&](Scored scored) {
+        if (best.size() < MAX_SUGGESTIONS) {
+            best.push(scored);
+        } else if (better(scored, best.top())) {
+            best.pop();
+            best.push(scored);
+        }
+    };
+
+    auto level_size = [](const auto& runs, int level) {
+        const uint32_t inner = level + 1 < runs.size() ? runs[level + 1].second - runs[level + 1].first : 0;
+        return runs[level].second - runs[level].first - inner;
+    };
+    // Calls f(rank) for each rank of the level : the run without its inner run.
+    auto for_each_rank = [](const auto& runs, int level, auto&& f) {
+        auto [begin, end] = runs[level];
+        auto [inner_begin, inner_end] = level + 1 < runs.size() ? runs[level + 1] : std::pair{end, end};
+        for (uint32_t rank = begin; rank < inner_begin; ++rank) {
+            f(rank);
+        }
+        for (uint32_t rank = inner_end; rank < end; ++rank) {
+            f(rank);
+        }
+    };
+
+    // Level 0 of either side holds every word, so nothing is left once a side is read up to it.
+    while (next_prefix >= 0 && next_suffix >= 0) {
+        if (best.size() == MAX_SUGGESTIONS && best.top().closeness > next_prefix + next_suffix) {
+            break;
+        }
+        // Read the smaller of the two levels; each word gets its closeness once, when it is first read.
+        if (level_size(prefix_runs, next_prefix) <= level_size(suffix_runs, next_suffix)) {
+            for_each_rank(prefix_runs, next_prefix, [&](uint32_t id) {
+                const std::size_t suffix = common_prefix_length<Reversed>(word(id), input);
+                // A word sharing a longer suffix is in a suffix level read before.
+                if (suffix <= next_suffix) {
+                    offer({static_cast<uint32_t>(next_prefix + suffix), id});
+                }
+            });
+            --next_prefix;
+        } else {
+            for_each_rank(suffix_runs, next_suffix, [&](uint32_t rank) {
+                const uint32_t id = by_suffix[rank];
+                const std::size_t prefix = common_prefix_length<Identity>(word(id), input);
+                if (prefix <= next_prefix) {
+                    offer({static_cast<uint32_t>(prefix + next_suffix), id});
+                }
+            });
+            --next_suffix;
+        }
+    }
+
+    std::vector<std::string> ret(best.size());
+    for (auto it = ret.rbegin(); it != ret.rend(); ++it) {
+        *it = word(best.top().id);
+        best.pop();
+    }
+    return ret;
+}
+
+std::vector<std::string_view> Lexicon::segment(std::string_view text) const {
+    const std::size_t n = text.size();
+    // The cost of a word : 1 to count the words, or its -log(probability) with weights.
+    const double log_total = std::log(static_cast<double>(weight_sum + word_num));
+    auto cost_of = [this, log_total](uint32_t id) {
+        return weights == nullptr ? 1.0 : log_total - std::log(static_cast<double>(weights[id]) + 1);
+    };
+
+    // best[i] is the cost of the best split of text[i, n), and next[i] the end of its first word; infinite if none.
+    constexpr double NO_SPLIT = std::numeric_limits<double>::infinity();
+    std::vector<double> best(n + 1, NO_SPLIT);
+    std::vector<std::size_t> next(n + 1, n);
+    best[n] = 0;
+    for (std::size_t i = n; i-- > 0;) {
+        State state = root_state();
+        for (std::size_t j = i; j < n; ++j) {
+            state = child_state(state, text[j]);
+            if (state.begin == state.end) {
+                break;
+            }
+            // Among splits of the same cost, the longer first word wins, since j only grows.
+            if (is_end_state(state) && best[j + 1] != NO_SPLIT && cost_of(state.begin) + best[j + 1] <= best[i]) {
+                best[i] = cost_of(state.begin) + best[j + 1];
+                next[i] = j + 1;
+            }
+        }
+    }
+
+    std::vector<std::string_view> words;
+    if (n == 0 || best[0] == NO_SPLIT) {
+        return words;
+    }
+    for (std::size_t i = 0; i < n; i = next[i]) {
+        words.push_back(text.substr(i, next[i] - i));
+    }
+    return words;
+}
+
+std::vector<std::string> Lexicon::traverse(const int MAX_VEC_SIZE) const {
+    std::vector<std::string> ret;
+    for (uint32_t id = 0; id < word_num && ret.size() < MAX_VEC_SIZE; ++id) {
+        ret.emplace_back(word(id));
+    }
+    return ret;
+}
+
+Lexicon::State Lexicon::root_state() const {
+    return {0, static_cast<uint32_t>(word_num), 0};
+}
+
+bool Lexicon::is_end_state(const State &state) const {
+    return state.begin < state.end && offsets[state.begin + 1] - offsets[state.begin] == state.depth;
+}
+
+std::size_t Lexicon::size() const {
+    return word_num;
+}
+
+std::size_t Lexicon::pool_size() const {
+    return offsets[word_num];
+}
+
+std::size_t Lexicon::memory_usage() const {
+    return sizeof(Lexicon) + offsets_data.capacity() * sizeof(uint32_t) + by_suffix_data.capacity() * sizeof(uint32_t)
+           + pool_data.capacity() + bucket_begin.capacity() * sizeof(uint32_t)
+           + weights_data.capacity() * sizeof(uint32_t) + weight_tree.capacity() * sizeof(uint32_t)
+           + (filter ? filter->memory_usage() - sizeof(BloomFilter) : 0);
+}
@@ -0,0 +1,206 @@
+#ifndef OOPFINAL_LEXICON_H
+#define OOPFINAL_LEXICON_H
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "mint_utils.h"
+#include "generator.h"
+#include "bloom_filter.h"
+
+class Lexicon {
+    /*
+     "Lexicon" holds a dictionary once, and answers the questions we used to ask a forward and a reversed trie.
+     The words are kept back to back in one pool, sorted alphabetically; the id of a word is its rank in that order.
+     A second array keeps the same ids sorted by the reversed words, i.e. by their suffixes :
+        words (by prefix) : 0 bad   1 bed   2 bid   3 cab
+        by_suffix         : 3 (bac) 0 (dab) 1 (deb) 2 (dib)
+
+     In the alphabetical order, the words sharing a prefix form one run, and the run of the longest prefix shared with
+     any word is found by binary search around the place where the input would go. That run, in order, is exactly
+     what Trie::get_suggestions returns; the same search over by_suffix gives what ReversedTrie::get_suggestions returns.
+     For the edit distance search, a run of words sharing the first d letters plays the part of a trie node at depth d,
+     and its children are the sub-runs split by the (d + 1)-th letter (See edit_distance.h.)
+
+     Like FrozenTrie, the arrays are read through plain pointers, so they may live in the vectors owned by this object
+     or in a mapped dictionary image (See dict_image.h.)
+
+     The words may have weights, such as how often they are used; weights[id] is the weight of the word id.
+     For the heaviest words of a run, a max tree is kept over the weights in the alphabetical order : a complete binary tree
+     whose leaves are the weights and whose every other node holds the largest weight below it (See get_top_suggestions.)
+     */
+    const uint32_t*         offsets;    // The word of id i is pool[offsets[i], offsets[i + 1]).
+    const uint32_t*         by_suffix;
+    const char*             pool;
+    const uint32_t*         weights;    // nullptr if the words have no weights, i.e. all of them weigh 0.
+    std::size_t             word_num;
+    // Storage of the arrays when this Lexicon owns them; empty for a view on borrowed memory.
+    std::vector<uint32_t>   offsets_data, by_suffix_data, weights_data;
+    std::vector<char>       pool_data;      // Not a std::string : moving a short string copies its letters to a new place.
+
+    /*
+     The words starting with the same two letters are one run, so a lookup first picks the run of its first two letters
+     and then does a binary search only there; bucket_begin[k] is the first id of the run with the key k (See bucket_of.)
+     It is made when a Lexicon is created, with one binary search per key, and is not a part of an image.
+     */
+    static constexpr int BUCKET_NUM = 27 * 27;
+    std::vector<uint32_t>   bucket_begin;
+
+    /*
+     The max tree : node 1 is the root, the children of the node n are 2n and 2n + 1, and the weight of the word id
+     is the leaf weight_leaves + id. Like the buckets, it is made when a Lexicon is created, and only if it has weights.
+     */
+    std::vector<uint32_t>   weight_tree;
+    std::size_t             weight_leaves = 0;
+    uint64_t                weight_sum = 0;
+
+    /*
+     An optional front for _contains_ : a word the filter rejects is surely not in the Lexicon, so it is answered
+     with one hash and one cache line instead of a binary search. Like the buckets, it is not a part of an image.
+     */
+    std::optional<BloomFilter> filter;
+
+    friend class DictionaryImage;
+
+public:
+    /*
+     Words with characters other than 'a' to 'z' are skipped, like Trie::push does; duplicates are kept once, with their
+     largest weight. 'word_weights' is empty, or holds the weight of each word; if all of them are 0, no weight is kept.
+     */
+    explicit Lexicon(const std::vector<std::string>& words, const std::vector<uint32_t>& word_weights = {});
+    // A view on arrays owned by someone else; they must outlive this Lexicon.
+    Lexicon(const uint32_t* _offsets, const uint32_t* _by_suffix, const char* _pool, std::size_t _word_num,
+            const uint32_t* _weights = nullptr);
+
+    Lexicon(Lexicon&&) = default;
+    Lexicon& operator=(Lexicon&&) = default;
+    Lexicon(const Lexicon&) = delete;
+    Lexicon& operator=(const Lexicon&) = delete;
+
+    // A run of the words sharing their first 'depth' letters : the ids [begin, end) in the alphabetical order.
+    struct State {
+        uint32_t    begin, end, depth;
+    };
+
+private:
+    /*
+     Same words as Trie::get_suggestions (with Identity) and ReversedTrie::get_suggestions (with Reversed) :
+     the run of words sharing the longest prefix of 'input' in the order of the Transform, as ranks [first, second).
+     */
+    template<typename Transform>
+    [[nodiscard]] std::pair<uint32_t, uint32_t> closest_run(std::string_view input) const;
+    template<typename Transform>
+    [[nodiscard]] mints::Generator<std::string_view> closest(std::string input) const;
+    /*
+     The runs of the words sharing the first 0, 1, 2, ... letters with 'input' in the order of the Transform, as ranks :
+     runs[l] holds runs[l + 1], and the last one is the longest prefix shared with any word.
+     */
+    template<typename Transform>
+    [[nodiscard]] std::vector<std::pair<uint32_t, uint32_t>> nested_runs(std::string_view input) const;
+
+    // The run of the words in 'state' whose next letter is c; an empty run if there is none.
+    [[nodiscard]] State child_state(const State& state, char c) const;
+
+    // The id of the word at 'rank' in the order of the Transform
+    template<typename Transform>
+    [[nodiscard]] uint32_t id_at(uint32_t rank) const;
+
+    // 27 * (first letter + 1) + (second letter + 1), a missing letter counting as -1; -1 for a word with other characters.
+    // The keys follow the alphabetical order of the words.
+    [[nodiscard]] static int bucket_of(std::string_view word);
+    void make_buckets();
+    void make_weight_tree();
+    // Insert every word into 'empty' and put it in front of _contains_.
+    void fill_filter(BloomFilter empty);
+
+public:
+    [[nodiscard]] std::string_view word(uint32_t id) const;
+    [[nodiscard]] uint32_t weight(uint32_t id) const;
+    [[nodiscard]] bool has_weights() const;
+
+    // Put a BloomFilter of the given false positive rate, or of at most 'max_bytes' bytes, in front of _contains_.
+    void build_filter(double false_positive_rate);
+    void build_filter_within(std::size_t max_bytes);
+    void drop_filter();
+    // The filter in front of _contains_, or nullptr if there is none
+    [[nodiscard]] const BloomFilter* get_filter() const;
+
+    [[nodiscard]] bool _contains_(std::string_view input) const;
+    [[nodiscard]] std::vector<bool> contains_many(std::span<const std::string> inputs) const;
+
+    // The words sharing the longest prefix with the input, alphabetically
+    [[nodiscard]] std::vector<std::string> get_suggestions_by_prefix(const std::string& input, int MAX_SUGGESTIONS) const;
+    // The words sharing the longest suffix with the input, in the order of their reversed words
+    [[nodiscard]] std::vector<std::string> get_suggestions_by_suffix(const std::string& input, int MAX_SUGGESTIONS) const;
+    /*
+     Same words as the two above, one at a time, so that the caller may stop or skip as they come.
+     The views point into the pool of this Lexicon, so unlike those of Trie::suggestions they stay valid as long as it lives.
+     */
+    [[nodiscard]] mints::Generator<std::string_view> suggestions_by_prefix(std::string input) const;
+    [[nodiscard]] mints::Generator<std::string_view> suggestions_by_suffix(std::string input) const;
+    // Same as Trie::get_suggestions_within (See edit_distance.h.)
+    [[nodiscard]] std::vector<std::string> get_suggestions_within(const std::string& input, int max_distance,
+                                                                  int MAX_SUGGESTIONS) const;
+    /*
+     The heaviest MAX_SUGGESTIONS words among those get_suggestions_by_prefix chooses from, heaviest first and
+     alphabetically among equals. The max tree is searched best-first from the O(log n) nodes covering the run,
+     so it takes O(MAX_SUGGESTIONS * log n) however long the run is. Without weights, these are the first words of the run.
+     */
+    [[nodiscard]] std::vector<std::string> get_top_suggestions(const std::string& input, int MAX_SUGGESTIONS) const;
+    /*
+     The words of the highest closeness to the input, highest first, then the heavier first, then alphabetically; the closeness
+     of a word is the length of the prefix it shares with the input plus that of the suffix (See the .cpp file.)
+     */
+    [[nodiscard]] std::vector<std::string> get_suggestions_by_closeness(const std::string& input, int MAX_SUGGESTIONS) const;
+
+    /*
+     Split a run of letters into words of the Lexicon, i.e. "theprogramisclosed" into {"the", "program", "is", "closed"}.
+     The views point into 'text'. Empty if the text cannot be split, or is empty.
+     From every position, one walk down the runs finds all the words starting there, so that is O(n * the longest word)
+     steps; a dynamic program then takes the best split of the rest for each of them, from the end of the text back.
+     The best split has the fewest words; with weights, it is the most likely one instead, taking the weight of a word
+     as how often it is used : the sum of -log((weight + 1) / (total weight + the number of words)) is the smallest.
+     */
+    [[nodiscard]] std::vector<std::string_view> segment(std::string_view text) const;
+
+    // At most MAX_VEC_SIZE words in alphabetical order
+    [[nodiscard]] std::vector<std::string> traverse(int MAX_VEC_SIZE) const;
+
+    // Walking functions used by the search algorithms : a 'state' is a run of words (See State.)
+    [[nodiscard]] State root_state() const;
+    [[nodiscard]] bool is_end_state(const State& state) const;
+    template<typename F>
+    void for_each_child(const State& state, F&& f) const {
+        uint32_t begin = state.begin;
+        // Only the first word of a run can end at its depth, and it has no letter to split by.
+        if (begin < state.end && offsets[begin + 1] - offsets[begin] == state.depth) {
+            ++begin;
+        }
+        while (begin < state.end) {
+            const char c = pool[offsets[begin] + state.depth];
+            // Binary search for the end of the words having c as their next letter
+            uint32_t lo = begin + 1, hi = state.end;
+            while (lo < hi) {
+                const uint32_t mid = lo + (hi - lo) / 2;
+                if (pool[offsets[mid] + state.depth] <= c) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            f(c, State{begin, lo, state.depth + 1});
+            begin = lo;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const;
+    // Total length of the words
+    [[nodiscard]] std::size_t pool_size() const;
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+#endif //OOPFINAL_LEXICON_H
@@ -1,20 +1,47 @@
 #include "listener.h"
 
-Listener::Listener(const std::vector<std::string> &sd, const std::vector<std::string> &strd)
+#include <cctype>
+#include <thread>
+
+Listener::Listener(const std::vector<std::string> &sd, const std::string &dict_image_path,
+                   const std::string &_shards_path, const std::string &_hangul_path, bool _dict_filter)
         : how_many_words_do_you_want(10),
           doc_ptr(new Document(sd)),
-          trie_ptr1(new Trie(strd, mints::identity_str, mints::identity_str)),
-          trie_ptr2(new Trie(strd, mints::reversed_str, mints::reversed_str)) {}
+          dict_ptr(new DictionaryImage(dict_image_path)),
+          dict_filter(_dict_filter),
+          symspell_ptr(nullptr),
+          completion_trie_ptr(nullptr),
+          frozen_trie_ptr(nullptr),
+          dawg_ptr(nullptr),
+          shards_ptr(nullptr),
+          shards_path(_shards_path),
+          hangul_ptr(nullptr),
+          hangul_path(_hangul_path) {}
 
 Listener::~Listener() {
     if (doc_ptr != nullptr) {
         delete doc_ptr;
     }
-    if (trie_ptr1 != nullptr) {
-        delete trie_ptr1;
+    if (dict_ptr != nullptr) {
+        delete dict_ptr;
+    }
+    if (symspell_ptr != nullptr) {
+        delete symspell_ptr;
+    }
+    if (completion_trie_ptr != nullptr) {
+        delete completion_trie_ptr;
+    }
+    if (frozen_trie_ptr != nullptr) {
+        delete frozen_trie_ptr;
+    }
+    if (dawg_ptr != nullptr) {
+        delete dawg_ptr;
     }
-    if (trie_ptr2 != nullptr) {
-        delete trie_ptr2;
+    if (shards_ptr != nullptr) {
+        delete shards_ptr;
+    }
+    if (hangul_ptr != nullptr) {
+        delete hangul_ptr;
     }
 }
 
@@ -160,6 +187,15 @@ std::string Listener::listen() {
 
                     doc_ptr->remove_holder(idx_to_delete); break;
 
+                case 30:
+                    find_words(); break;
+
+                case 31:
+                    replace_words(); break;
+
+                case 32:
+                    match_words(); break;
+
                 default:
                     break;
             }
@@ -242,7 +278,12 @@ void Listener::modify_str(StringHolder *p) {
                 --idx;
                 std::cout << "Put your text you want to push back : " << std::endl;
                 getline(std::cin, input_str);
-                p->insert(idx, input_str); break;
+                p->insert(idx, complete_last_word(input_str)); break;
+
+            case 12:
+                std::cout << "Put your text you want to push back, ending with the beginning of a word : " << std::endl;
+                getline(std::cin, input_str);
+                p->push(complete_last_word(input_str)); break;
 
             case 20:
                 std::cout << "Put the index where you want to delete : ";
@@ -273,7 +314,7 @@ void Listener::modify_str(StringHolder *p) {
                 std::cout << "Put the text you want to insert : ";
                 getline(std::cin, input_str);
 
-                p->insert(idx, input_str); break;
+                p->insert(idx, complete_last_word(input_str)); break;
 
             case 50:
                 p->title_on(); break;
@@ -281,8 +322,50 @@ void Listener::modify_str(StringHolder *p) {
             case 51:
                 p->title_off(); break;
 
+            case 92:
+                p->spellcheck(hangul_dict(), how_many_words_do_you_want); break;
+
+            case 93:
+                // The DAWG merges the common suffixes of the Trie, so show what that saves when it is built.
+                if (dawg_ptr == nullptr) {
+                    const Trie& trie = completion_trie();
+                    dawg_ptr = new Dawg(trie.traverse((int) dict_ptr->lexicon().size()));
+                    std::cout << "The DAWG has " << dawg_ptr->node_num() << " states in " << dawg_ptr->memory_usage()
+                              << " bytes, for the " << trie.node_num() << " nodes in " << trie.memory_usage()
+                              << " bytes of the Trie." << std::endl;
+                }
+                p->spellcheck(*dawg_ptr, how_many_words_do_you_want); break;
+
+            case 94:
+                // The double array looks words up faster than the Lexicon, but it is made from a Trie, so only on demand.
+                if (frozen_trie_ptr == nullptr) {
+                    frozen_trie_ptr = new FrozenTrie(completion_trie().freeze());
+                }
+                p->spellcheck(*frozen_trie_ptr, how_many_words_do_you_want); break;
+
+            case 95:
+                if (shards_ptr == nullptr) {
+                    shards_ptr = new ShardedDictionary(shards_path);
+                }
+                p->spellcheck(*shards_ptr, how_many_words_do_you_want);
+                std::cout << shards_ptr->resident_shard_num() << " shards of the dictionary are loaded." << std::endl; break;
+
+            case 96:
+                std::cout << p->fix_spacing(spellcheck_dict()) << " words were split." << std::endl; break;
+
+            case 97:
+                // The index costs a lot more memory than the lexicon, so it is built only when someone asks for it.
+                if (symspell_ptr == nullptr) {
+                    const Lexicon& dict = dict_ptr->lexicon();
+                    symspell_ptr = new SymSpellIndex(dict.traverse((int) dict.size()));
+                }
+                p->spellcheck(*symspell_ptr, how_many_words_do_you_want); break;
+
+            case 98:
+                p->spellcheck(spellcheck_dict(), how_many_words_do_you_want, StringHolder::BY_EDIT_DISTANCE); break;
+
             case 99:
-                p->spellcheck(*trie_ptr1, *trie_ptr2, how_many_words_do_you_want); break;
+                p->spellcheck(spellcheck_dict(), how_many_words_do_you_want); break;
 
             default:
                 break;
@@ -290,6 +373,87 @@ void Listener::modify_str(StringHolder *p) {
     }
 }
 
+const Trie &Listener::completion_trie() {
+    if (completion_trie_ptr == nullptr) {
+        // The lexicon gives its words sorted, so the Trie is built in one pass, by as many threads as the machine has.
+        // The weights are pushed afterwards, so that the completions come heaviest first as the lexicon has them.
+        const Lexicon& dict = dict_ptr->lexicon();
+        completion_trie_ptr = new Trie(dict.traverse((int) dict.size()), std::thread::hardware_concurrency());
+        if (dict.has_weights()) {
+            for (uint32_t id = 0; id < dict.size(); ++id) {
+                if (dict.weight(id) > 0) {
+                    completion_trie_ptr->push(std::string(dict.word(id)), dict.weight(id));
+                }
+            }
+        }
+    }
+    return *completion_trie_ptr;
+}
+
+const Lexicon &Listener::spellcheck_dict() {
+    if (dict_filter && dict_ptr->lexicon().get_filter() == nullptr) {
+        dict_ptr->build_filter(DICT_FILTER_RATE);
+    }
+    return dict_ptr->lexicon();
+}
+
+const HangulTrie &Listener::hangul_dict() {
+    if (hangul_ptr == nullptr) {
+        if (hangul_path.empty()) {
+            throw mints::unable_to_open_file("No Korean word list : start the program with --hangul <word list>");
+        }
+        // The words are put at once, and the weighted ones again with their weights, as for the completion Trie.
+        const std::vector<mints::DictEntry> entries = mints::read_dict(hangul_path);
+        std::vector<std::string> words;
+        words.reserve(entries.size());
+        for (const mints::DictEntry& entry : entries) {
+            words.push_back(entry.word);
+        }
+        hangul_ptr = new HangulTrie(words);
+        for (const mints::DictEntry& entry : entries) {
+            if (entry.weight > 0) {
+                hangul_ptr->push(entry.word, entry.weight);
+            }
+        }
+    }
+    return *hangul_ptr;
+}
+
+std::string Listener::complete_last_word(const std::string &text) {
+    Trie::Cursor cursor = completion_trie().cursor();
+    for (char c : text) {
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+            cursor.advance((char) std::tolower(static_cast<unsigned char>(c)));
+        } else {
+            cursor.reset();
+        }
+    }
+
+    const std::size_t typed_len = cursor.get_typed().size();
+    const std::vector<std::string> completions = cursor.completions(how_many_words_do_you_want);
+    if (typed_len == 0 || completions.empty()) {
+        return text;
+    }
+
+    std::cout << "The completions of '" << text.substr(text.size() - typed_len) << "' are: " << std::endl;
+    for (int i = 0; i < completions.size(); ++i) {
+        std::cout << i + 1 << " " << completions[i] << " | ";
+    } std::cout << std::endl;
+
+    int idx;
+    do {
+        std::cout << "Put a number if you want to complete (Put 0 if you don't want) : ";
+        std::cin >> idx;
+        std::cin.ignore(1000, '\n');
+    } while (idx < 0 || idx > completions.size());
+
+    if (idx == 0) {
+        return text;
+    }
+    // The letters already typed are kept as they were typed; only the rest of the word is added.
+    return text + completions[idx - 1].substr(typed_len);
+}
+
 void Listener::modify_tab(TableHolder *p) {
     std::cout << "Accessed to the TableHolder named " << p->get_title() << std::endl;
     std::cout << "To see the manual, input 0.\n\n";
@@ -442,3 +606,99 @@ void Listener::modify_cha(ChartHolder *p) {
         }
     }
 }
+
+void Listener::find_words() {
+    std::vector<std::string> words;
+    std::string word;
+    std::cout << "Put the words to find, one per line, and an empty line to end : " << std::endl;
+    while (getline(std::cin, word) && !word.empty()) {
+        words.push_back(word);
+    }
+    if (words.empty()) {
+        return;
+    }
+
+    std::cout << "Ignore the case? (1 yes / 0 no) : ";
+    int ignore_case;
+    std::cin >> ignore_case;
+    std::cin.ignore(1000, '\n');
+
+    const AhoCorasick patterns(words, ignore_case == 1);
+    const auto found = doc_ptr->find_all(patterns);
+    if (found.empty()) {
+        std::cout << "No word was found." << std::endl << std::endl;
+        return;
+    }
+    for (const auto& [holder_idx, matches] : found) {
+        std::cout << "In the holder #" << holder_idx + 1 << " :" << std::endl;
+        for (const auto& match : matches) {
+            // Positions are shown from 1, as the index numbers of the holder commands are.
+            std::cout << "'" << patterns.get_pattern(match.pattern) << "' at " << match.pos + 1 << " | ";
+        } std::cout << std::endl;
+    } std::cout << std::endl;
+}
+
+void Listener::replace_words() {
+    std::vector<std::string> words, replacements;
+    std::string word, replacement;
+    std::cout << "Put a word to replace and its replacement on the next line, and an empty word to end : " << std::endl;
+    while (getline(std::cin, word) && !word.empty() && getline(std::cin, replacement)) {
+        words.push_back(word);
+        replacements.push_back(replacement);
+    }
+    if (words.empty()) {
+        return;
+    }
+
+    std::cout << "Ignore the case? (1 yes / 0 no) : ";
+    int ignore_case;
+    std::cin >> ignore_case;
+    std::cin.ignore(1000, '\n');
+
+    const AhoCorasick patterns(words, ignore_case == 1);
+    std::cout << doc_ptr->replace_all(patterns, replacements) << " words were replaced." << std::endl << std::endl;
+}
+
+void Listener::match_words() {
+    std::string pattern;
+    std::cout << "Put a pattern to look up in the dictionary ('?' a letter, '*' any letters, [abc] one of them) : ";
+    getline(std::cin, pattern);
+    pattern = mints::make_lowercase(pattern);
+
+    // A pattern starting with '*' may match below any node, so the Trie walks all of it, which is slower than a scan of
+    // the words of the lexicon (See bench_wildcard); both give the words alphabetically.
+    int count = 0;
+    bool more = false;
+    auto print = [this, &count, &more](std::string_view word) {
+        if (count == how_many_words_do_you_want) {
+            more = true;
+            return false;
+        }
+        std::cout << ++count << " " << word << " | ";
+        return true;
+    };
+    if (pattern.starts_with('*')) {
+        const WildcardPattern compiled(pattern);
+        const Lexicon& dict = dict_ptr->lexicon();
+        for (uint32_t id = 0; id < dict.size(); ++id) {
+            if (compiled.matches(dict.word(id)) && !print(dict.word(id))) {
+                break;
+            }
+        }
+    } else {
+        for (std::string_view word : completion_trie().match(pattern)) {
+            if (!print(word)) {
+                break;
+            }
+        }
+    }
+    if (count == 0) {
+        std::cout << "No word of the dictionary matches '" << pattern << "'." << std::endl << std::endl;
+        return;
+    }
+    std::cout << std::endl;
+    if (more) {
+        std::cout << "Only the first " << count << " words are shown." << std::endl;
+    }
+    std::cout << std::endl;
+}
@@ -2,16 +2,37 @@
 #define OOPFINAL_LISTENER_H
 
 #include "docus.h"
+#include "dict_image.h"
 
 class Listener {
     Document*   doc_ptr;
-    Trie*       trie_ptr1;
-    Trie*       trie_ptr2;
+    // The dictionary is never modified during a session, so it is mapped from a compiled image.
+    DictionaryImage* dict_ptr;
+    // Whether the spell-checks put a BloomFilter in front of the dictionary (See spellcheck_dict.)
+    bool        dict_filter;
+    // Built from the dictionary on the first spell-check that needs it
+    SymSpellIndex* symspell_ptr;
+    // Built from the dictionary on the first word completion
+    Trie*       completion_trie_ptr;
+    // Frozen from the completion Trie on the first spell-check that needs it
+    FrozenTrie* frozen_trie_ptr;
+    // Built from the completion Trie on the first spell-check that needs it
+    Dawg*       dawg_ptr;
+    // Opened on the first spell-check that needs it; reads the shards of the dictionary as the words need them
+    ShardedDictionary* shards_ptr;
+    std::string shards_path;
+    // Loaded from the Korean word list on the first Korean spell-check; there is none if no list was given.
+    HangulTrie* hangul_ptr;
+    std::string hangul_path;
     int         how_many_words_do_you_want;
 
+    // The false positive rate of the filter put in front of the dictionary for the spell-checks (See BloomFilter.)
+    static constexpr double DICT_FILTER_RATE = 0.01;
+
 public:
 
-    Listener(const std::vector<std::string>& sd, const std::vector<std::string>& strd);
+    Listener(const std::vector<std::string>& sd, const std::string& dict_image_path, const std::string& _shards_path,
+             const std::string& _hangul_path = "", bool _dict_filter = false);
     ~Listener();
 
     std::string listen();
@@ -38,6 +59,38 @@ private:
     static void modify_tab(TableHolder* p);
     static void modify_cha(ChartHolder* p);
 
+    /*
+     Feed the text to a Trie::Cursor letter by letter, as if it were typed; a character other than a letter ends a word.
+     If the text ends in the middle of a word, offer the completions of that word and put the chosen one in its place.
+     Every text put into a StringHolder goes through it but that of command 10, the plain push :
+     command 12 pushes, and commands 11 and 21 insert.
+     */
+    std::string complete_last_word(const std::string& text);
+    // The Trie of the dictionary for word completion, built on the first call
+    const Trie& completion_trie();
+    /*
+     The dictionary for the spell-checks on the Lexicon. With dict_filter, a BloomFilter is built in front of its lookups
+     on the first call, so that a misspelled word is mostly turned down without a search of the words.
+     It stays off by default : building it hashes every word, and a text mostly spelled right looks up slower through it
+     (See bench_bloom_filter.)
+     */
+    const Lexicon& spellcheck_dict();
+    // The Korean words of the list at hangul_path, read on the first call. Throws unable_to_open_file if there is no list.
+    const HangulTrie& hangul_dict();
+
+    /*
+     Read the words to look for, one per line up to an empty line, and find them in every StringHolder at once.
+     replace_words reads a replacement after each word, and replaces every occurrence in the document.
+     */
+    void        find_words();
+    void        replace_words();
+    /*
+     Read a wildcard pattern like "cro?sw*d" (See wildcard.h) and print the dictionary words matching it, alphabetically.
+     The matches are taken from Trie::match one at a time, so the search stops at the first how_many_words_do_you_want;
+     a pattern starting with '*' is run over the words of the lexicon instead.
+     */
+    void        match_words();
+
     std::string save() {
         return doc_ptr->save();
     }
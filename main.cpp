@@ -10,9 +10,16 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <cstdint>
 
 class Node;
-class Trie;
+template<typename Alphabet, typename Transform> class BasicTrie;
+class FrozenTrie;
+class Lexicon;
+class DictionaryImage;
+class SymSpellIndex;
+class HangulTrie;
+class ShardedDictionary;
 class Document;
 class Holder;
 class TestHolder;
@@ -28,26 +35,57 @@ class Listener;
 #include "docus.h"
 #include "listener.h"
 
-int main() {
-    std::ifstream ifile("../tester.txt"), triefile("../dict.txt");
-    std::string str; std::vector<std::string> scanned_data, scanned_trie_data;
+int main(int argc, char** argv) {
+    // "--hangul <word list>" gives a list of Korean words, one per line as in dict.txt, for the Korean spell-check.
+    // "--bloom-filter" puts a BloomFilter in front of the dictionary for the spell-checks, for texts mostly misspelled.
+    std::string hangul_path;
+    bool dict_filter = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--hangul" && i + 1 < argc) {
+            hangul_path = argv[++i];
+        } else if (std::string(argv[i]) == "--bloom-filter") {
+            dict_filter = true;
+        } else {
+            std::cerr << "Usage : " << argv[0] << " [--hangul <word list>] [--bloom-filter]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::ifstream ifile("../tester.txt");
+    std::string str; std::vector<std::string> scanned_data;
 
     if (not ifile) {
         throw mints::unable_to_open_file("Unable to open file : {name : tester.txt}");
     }
-    if (not triefile) {
-        throw mints::unable_to_open_file("Unable to open file : {name : dict.txt}");
-    }
 
     while (getline(ifile, str)) {
         scanned_data.push_back(str);
     }
-    while (getline(triefile, str)) {
-        std::string lower_str = mints::make_lowercase(str);
-        scanned_trie_data.push_back(lower_str);
+
+    // The dictionary is compiled into dict.img and dict.shards only when dict.txt is new; otherwise we just map the image,
+    // and the shards are read as the spell-check needs them.
+    const bool image_up_to_date = DictionaryImage::is_up_to_date("../dict.img", "../dict.txt");
+    const bool shards_up_to_date = ShardedDictionary::is_up_to_date("../dict.shards", "../dict.txt");
+    if (not image_up_to_date or not shards_up_to_date) {
+        std::vector<std::string> scanned_trie_data;
+        std::vector<uint32_t> scanned_weights;
+
+        // A line holds a word, and may hold its weight after it : i.e. "abandon 1520". A word without one weighs 0.
+        // A line which holds anything else is skipped with a warning, rather than read as a part of it.
+        for (mints::DictEntry& entry : mints::read_dict("../dict.txt")) {
+            scanned_trie_data.push_back(std::move(entry.word));
+            scanned_weights.push_back(entry.weight);
+        }
+
+        if (not image_up_to_date) {
+            DictionaryImage::compile(scanned_trie_data, scanned_weights, "../dict.img");
+        }
+        if (not shards_up_to_date) {
+            ShardedDictionary::compile(scanned_trie_data, "../dict.shards");
+        }
     }
 
-    Listener listener(scanned_data, scanned_trie_data);
+    Listener listener(scanned_data, "../dict.img", "../dict.shards", hangul_path, dict_filter);
     auto save_data = listener.listen();
 
     std::ofstream ofile("tester.txt");
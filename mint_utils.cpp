@@ -1,5 +1,12 @@
 #include "mint_utils.h"
 
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <unistd.h>
+
 /**
  * 임의의 문자열을 입력으로 받아, 문자열의 모든 대문자를 소문자로 바꾸는 함수
  * @param str 임의의 문자열
@@ -28,6 +35,74 @@ std::vector<std::string> mints::split(const std::string &str) {
     return vecstr;
 }
 
+mints::DictEntry mints::parse_dict_line(const std::string &line) {
+    std::istringstream tokens(make_lowercase(line));
+    DictEntry entry;
+    std::string weight, rest;
+    tokens >> entry.word >> weight >> rest;
+    if (!rest.empty()) {
+        throw invalid_file_format("More than a word and a weight : {line : " + line + "}");
+    }
+    if (weight.empty()) {
+        return entry;
+    }
+    if (weight.size() > 10 || !std::ranges::all_of(weight, [](char c) { return '0' <= c && c <= '9'; })) {
+        throw invalid_file_format("The word is followed by something other than a weight : {line : " + line + "}");
+    }
+    const unsigned long long value = std::stoull(weight);
+    if (value > UINT32_MAX) {
+        throw invalid_file_format("The weight does not fit in 32 bits : {line : " + line + "}");
+    }
+    entry.weight = static_cast<uint32_t>(value);
+    return entry;
+}
+
+std::vector<mints::DictEntry> mints::read_dict(const std::string &path) {
+    std::ifstream ifile(path);
+    if (not ifile) {
+        throw unable_to_open_file("Unable to open file : {name : " + path + "}");
+    }
+    std::vector<DictEntry> entries;
+    std::string line;
+    for (int line_num = 1; getline(ifile, line); ++line_num) {
+        try {
+            entries.push_back(parse_dict_line(line));
+        } catch (const invalid_file_format& e) {
+            std::cerr << path << ":" << line_num << " is skipped : " << e.what() << std::endl;
+        }
+    }
+    return entries;
+}
+
+void mints::replace_file(const std::string &path, const std::function<void(std::ostream&)> &write_to) {
+    // The process id keeps two processes compiling at once off each other's temporary file.
+    const std::string temp_path = path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream ofile(temp_path, std::ios::binary | std::ios::trunc);
+        if (not ofile) {
+            throw unable_to_open_file("Unable to open file : {name : " + temp_path + "}");
+        }
+        try {
+            write_to(ofile);
+        } catch (...) {
+            ofile.close();
+            std::filesystem::remove(temp_path);
+            throw;
+        }
+        ofile.close();
+        if (not ofile) {
+            std::filesystem::remove(temp_path);
+            throw unable_to_open_file("Unable to write file : {name : " + temp_path + "}");
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path);
+        throw unable_to_open_file("Unable to replace file : {name : " + path + "} : " + ec.message());
+    }
+}
+
 /**
  * 입력 그대로 리턴하는 함수
  * @param str 임의의 문자열
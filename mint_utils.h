@@ -5,12 +5,21 @@
 #include <vector>
 #include <concepts>
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
 
 namespace mints {
 
     std::string                         make_lowercase(std::string str);
     std::vector<std::string>            split(const std::string& str);
 
+    // One line of a word list : a word, and may be its weight after it, i.e. "abandon 1520". A word without one weighs 0.
+    struct DictEntry {
+        std::string                     word;
+        uint32_t                        weight = 0;
+    };
+
     std::string identity_str(std::string str);
     std::string reversed_str(std::string str);
 
@@ -42,6 +51,27 @@ namespace mints {
     struct unable_to_open_file : named_exception {
         explicit unable_to_open_file(std::string s) : named_exception(std::move(s)) {}
     };
+    struct invalid_file_format : named_exception {
+        explicit invalid_file_format(std::string s) : named_exception(std::move(s)) {}
+    };
+    struct invalid_pattern : named_exception {
+        explicit invalid_pattern(std::string s) : named_exception(std::move(s)) {}
+    };
+
+    // The lowercased word of a line of a word list and its weight;
+    // throws invalid_file_format if the line holds more than a word and a weight, or the weight is not a 32-bit number
+    DictEntry                           parse_dict_line(const std::string& line);
+    // The entries of every line of a word list, by parse_dict_line; a line it refuses is skipped with a warning.
+    // Throws unable_to_open_file if the list cannot be opened.
+    std::vector<DictEntry>              read_dict(const std::string& path);
+    /*
+     Write the file at 'path' with 'write_to', into a temporary file of the same directory renamed over 'path' once it is
+     complete. A process which has the old file open or mapped keeps reading the old one, and a process opening it later
+     finds either the old or the new file, never a part of one.
+     Throws unable_to_open_file if the file cannot be written; 'path' is then left as it was.
+     */
+    void                                replace_file(const std::string& path,
+                                                     const std::function<void(std::ostream&)>& write_to);
 
 
 
@@ -83,18 +113,30 @@ namespace mint_manuals {
                                      "Put 22 to pop a holder at the END of the document.\n"
                                      "Put 23 to delete a holder in any place.\n"
                                      "\n"
+                                     "Put 30 to find words in every text holder.\n"
+                                     "Put 31 to replace words in every text holder.\n"
+                                     "Put 32 to look up the dictionary words matching a pattern like \"cro?sw*d\".\n"
+                                     "\n"
                                      "Put -1 to exit the program.\n\n"s};
 
     const std::string str_manual = "Put 1 to print all CONTENTS of the holder.\n"
                                    "Put 3 to change the title of holder.\n"
                                    "\n"
                                    "Put 10 to push your text at the back of the string.\n"
-                                   "Put 11 to insert your text between the data.\n"
+                                   "Put 11 to insert your text between the data, completing its last word.\n"
+                                   "Put 12 to push your text at the back, completing its last word.\n"
                                    "Put 20 to delete some elements between strings.\n"
-                                   "Put 21 to replace some elements between string into other.\n"
+                                   "Put 21 to replace some elements between string into other, completing its last word.\n"
                                    "Put 50 to print title.\n"
                                    "Put 51 to hide title.\n"
                                    "\n"
+                                   "Put 92 to operate the spell-check function on the Korean words, with the list given by --hangul.\n"
+                                   "Put 93 to operate the spell-check function with the DAWG, which shares the suffixes too.\n"
+                                   "Put 94 to operate the spell-check function with the frozen (double-array) trie.\n"
+                                   "Put 95 to operate the spell-check function with the dictionary loaded on demand.\n"
+                                   "Put 96 to put back the spaces lost between words.\n"
+                                   "Put 97 to operate the spell-check function by the symmetric-delete index.\n"
+                                   "Put 98 to operate the spell-check function by edit distance.\n"
                                    "Put 99 to operate the spell-check function.\n"
                                    "Put -1 to break.\n\n"s;
 
@@ -0,0 +1,359 @@
+#include "radix_trie.h"
+
+#include <bit>
+#include <utility>
+
+namespace {
+
+    // One step up in the text of to_txt_data : see Node::depth_first_search.
+    void ascend(std::string& str) {
+        if (97 <= str.back() && str.back() <= 122) {
+            str += '0';
+        } else {
+            ++str.back();
+        }
+    }
+
+}
+
+template<typename Alphabet, typename Transform>
+BasicRadixTrie<Alphabet, Transform>::BasicRadixTrie() : nodes(1, RadixNode{0, 0, 0, 0}) {}
+
+template<typename Alphabet, typename Transform>
+BasicRadixTrie<Alphabet, Transform>::BasicRadixTrie(const std::vector<std::string> &vs) : BasicRadixTrie() {
+    for (const auto& str : vs) {
+        push(str);
+    }
+}
+
+template<typename Alphabet, typename Transform>
+typename BasicRadixTrie<Alphabet, Transform>::Position
+BasicRadixTrie<Alphabet, Transform>::descend(std::string_view str) const {
+    Position pos{ROOT, ROOT, ROOT, 0, 0, 0};
+    while (pos.depth < str.size()) {
+        const uint32_t child = find_child(pos.node, Alphabet::index(Transform::at(str, pos.depth)));
+        if (child == ROOT) {
+            break;
+        }
+
+        // The first letter of the label is the one we came by; compare the rest.
+        const RadixNode& next = nodes[child];
+        std::size_t into = 1;
+        while (into < next.label_len && pos.depth + into < str.size()
+               && label_pool[next.label_begin + into] == Transform::at(str, pos.depth + into)) {
+            ++into;
+        }
+
+        pos = Position{child, pos.node, pos.parent, pos.depth + into, into, pos.hops + 1};
+        if (into < next.label_len) {
+            break;
+        }
+    }
+    return pos;
+}
+
+template<typename Alphabet, typename Transform>
+int BasicRadixTrie<Alphabet, Transform>::child_num(const RadixNode &node) {
+    return std::popcount(node.mask & ~END_BIT);
+}
+
+template<typename Alphabet, typename Transform>
+bool BasicRadixTrie<Alphabet, Transform>::is_end(uint32_t node) const {
+    return nodes[node].mask & END_BIT;
+}
+
+template<typename Alphabet, typename Transform>
+uint32_t BasicRadixTrie<Alphabet, Transform>::find_child(uint32_t node, int idx) const {
+    if (idx == -1) {
+        return ROOT;
+    }
+    const uint32_t bit = 1u << idx;
+    const RadixNode& n = nodes[node];
+    if (!(n.mask & bit)) {
+        return ROOT;
+    }
+    return child_pool[n.children + std::popcount(n.mask & ~END_BIT & (bit - 1))];
+}
+
+template<typename Alphabet, typename Transform>
+uint32_t BasicRadixTrie<Alphabet, Transform>::new_node(uint32_t label_begin, uint32_t label_len) {
+    uint32_t id;
+    if (free_nodes.empty()) {
+        id = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+    } else {
+        id = free_nodes.back();
+        free_nodes.pop_back();
+    }
+    nodes[id] = RadixNode{0, 0, label_begin, label_len};
+    return id;
+}
+
+template<typename Alphabet, typename Transform>
+uint32_t BasicRadixTrie<Alphabet, Transform>::new_block(int size) {
+    if (!free_blocks[size].empty()) {
+        const uint32_t block = free_blocks[size].back();
+        free_blocks[size].pop_back();
+        return block;
+    }
+    const auto block = static_cast<uint32_t>(child_pool.size());
+    child_pool.resize(child_pool.size() + size);
+    return block;
+}
+
+template<typename Alphabet, typename Transform>
+void BasicRadixTrie<Alphabet, Transform>::release_block(uint32_t block, int size) {
+    free_blocks[size].push_back(block);
+}
+
+template<typename Alphabet, typename Transform>
+void BasicRadixTrie<Alphabet, Transform>::link(uint32_t node, uint32_t child) {
+    const uint32_t bit = 1u << first_index(child);
+    RadixNode& n = nodes[node];
+    const int rank = std::popcount(n.mask & ~END_BIT & (bit - 1));
+    if (n.mask & bit) {
+        child_pool[n.children + rank] = child;
+        return;
+    }
+
+    const int size = child_num(n);
+    const uint32_t grown = new_block(size + 1);
+    for (int i = 0; i < rank; ++i) {
+        child_pool[grown + i] = child_pool[n.children + i];
+    }
+    child_pool[grown + rank] = child;
+    for (int i = rank; i < size; ++i) {
+        child_pool[grown + i + 1] = child_pool[n.children + i];
+    }
+    if (size > 0) {
+        release_block(n.children, size);
+    }
+    n.children = grown;
+    n.mask |= bit;
+}
+
+template<typename Alphabet, typename Transform>
+void BasicRadixTrie<Alphabet, Transform>::unlink(uint32_t node, int idx) {
+    const uint32_t bit = 1u << idx;
+    RadixNode& n = nodes[node];
+    const int rank = std::popcount(n.mask & ~END_BIT & (bit - 1));
+    const int size = child_num(n);
+
+    uint32_t shrunk = 0;
+    if (size > 1) {
+        shrunk = new_block(size - 1);
+        for (int i = 0; i < rank; ++i) {
+            child_pool[shrunk + i] = child_pool[n.children + i];
+        }
+        for (int i = rank + 1; i < size; ++i) {
+            child_pool[shrunk + i - 1] = child_pool[n.children + i];
+        }
+    }
+    release_block(n.children, size);
+    n.children = shrunk;
+    n.mask &= ~bit;
+}
+
+template<typename Alphabet, typename Transform>
+void BasicRadixTrie<Alphabet, Transform>::join_with_child(uint32_t parent, uint32_t node) {
+    const uint32_t child = child_pool[nodes[node].children];
+    const RadixNode upper = nodes[node];
+    RadixNode& lower = nodes[child];
+
+    if (upper.label_begin + upper.label_len == lower.label_begin) {
+        // The labels were one label before a split, so they are still next to each other.
+        lower.label_begin = upper.label_begin;
+    } else {
+        std::string joined = label_pool.substr(upper.label_begin, upper.label_len);
+        joined.append(label_pool, lower.label_begin, lower.label_len);
+        lower.label_begin = static_cast<uint32_t>(label_pool.size());
+        label_pool += joined;
+    }
+    lower.label_len += upper.label_len;
+
+    release_block(upper.children, 1);
+    link(parent, child);
+    free_nodes.push_back(node);
+}
+
+template<typename Alphabet, typename Transform>
+int BasicRadixTrie<Alphabet, Transform>::first_index(uint32_t node) const {
+    return Alphabet::index(label_pool[nodes[node].label_begin]);
+}
+
+template<typename Alphabet, typename Transform>
+std::vector<std::string> BasicRadixTrie<Alphabet, Transform>::traverse(uint32_t node, std::string prefix,
+                                                                       const int MAX_VEC_SIZE) const {
+    std::vector<std::string> vecstr;
+    vecstr.reserve(std::min(MAX_VEC_SIZE, Node::RESERVE_LIMIT));
+
+    // Do Depth-First-Search; each entry of the stack is (node, length of the path to its parent).
+    std::vector<std::pair<uint32_t, std::size_t>> stack;
+    stack.emplace_back(node, prefix.size());
+
+    while (!stack.empty()) {
+        auto [popped, len] = stack.back();
+        stack.pop_back();
+
+        const RadixNode& n = nodes[popped];
+        prefix.resize(len);
+        prefix.append(label_pool, n.label_begin, n.label_len);
+
+        if (n.mask & END_BIT) {
+            vecstr.push_back(prefix);
+            if (vecstr.size() >= MAX_VEC_SIZE) {
+                break;
+            }
+        }
+
+        // Push in reverse, so that the words come out alphabetically.
+        for (int i = child_num(n) - 1; i >= 0; --i) {
+            stack.emplace_back(child_pool[n.children + i], prefix.size());
+        }
+    }
+
+    return vecstr;
+}
+
+template<typename Alphabet, typename Transform>
+void BasicRadixTrie<Alphabet, Transform>::depth_first_search(uint32_t node, std::string &str) const {
+    const RadixNode& n = nodes[node];
+    str.append(label_pool, n.label_begin, n.label_len);
+    for (int i = 0; i < child_num(n); ++i) {
+        depth_first_search(child_pool[n.children + i], str);
+    }
+    // A label of k letters stands for k nodes of a Trie, so we go up k times.
+    for (uint32_t i = 0; i < n.label_len; ++i) {
+        ascend(str);
+    }
+}
+
+template<typename Alphabet, typename Transform>
+std::string BasicRadixTrie<Alphabet, Transform>::stored_prefix(std::string_view word, std::size_t length) {
+    std::string prefix;
+    prefix.reserve(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        prefix += Transform::at(word, i);
+    }
+    return prefix;
+}
+
+template<typename Alphabet, typename Transform>
+bool BasicRadixTrie<Alphabet, Transform>::_contains_(const std::string &input) const {
+    const Position pos = descend(input);
+    return pos.depth == input.size() && pos.into == nodes[pos.node].label_len && is_end(pos.node);
+}
+
+template<typename Alphabet, typename Transform>
+void BasicRadixTrie<Alphabet, Transform>::push(const std::string &input) {
+    // Check whether the pushed string does not contain characters out of the alphabet
+    for (char c : input) {
+        if (Alphabet::index(c) == -1) {
+            // if such a character is found, then do nothing
+            return;
+        }
+    }
+
+    Position pos = descend(input);
+
+    if (pos.into < nodes[pos.node].label_len) {
+        // The walk stopped inside an edge : split it, so that there is a node where the input leaves it.
+        const uint32_t middle = new_node(nodes[pos.node].label_begin, static_cast<uint32_t>(pos.into));
+        nodes[pos.node].label_begin += pos.into;
+        nodes[pos.node].label_len -= pos.into;
+        link(pos.parent, middle);
+        link(middle, pos.node);
+        pos.node = middle;
+    }
+
+    if (pos.depth == input.size()) {
+        nodes[pos.node].mask |= END_BIT;
+        return;
+    }
+
+    // The rest of the input is one new edge.
+    const auto label_begin = static_cast<uint32_t>(label_pool.size());
+    for (std::size_t i = pos.depth; i < input.size(); ++i) {
+        label_pool += Transform::at(input, i);
+    }
+    const uint32_t leaf = new_node(label_begin, static_cast<uint32_t>(input.size() - pos.depth));
+    nodes[leaf].mask = END_BIT;
+    link(pos.node, leaf);
+}
+
+template<typename Alphabet, typename Transform>
+void BasicRadixTrie<Alphabet, Transform>::remove(const std::string &str) {
+    const Position pos = descend(str);
+    if (pos.depth != str.size() || pos.into != nodes[pos.node].label_len || !is_end(pos.node)) {
+        // If str is not contained in our RadixTrie, then do nothing.
+        return;
+    }
+
+    nodes[pos.node].mask &= ~END_BIT;
+    if (pos.node == ROOT) {
+        return;
+    }
+
+    // Keep every node other than the root either a word or a branch.
+    const int children = child_num(nodes[pos.node]);
+    if (children == 0) {
+        unlink(pos.parent, first_index(pos.node));
+        free_nodes.push_back(pos.node);
+        if (pos.parent != ROOT && !is_end(pos.parent) && child_num(nodes[pos.parent]) == 1) {
+            join_with_child(pos.grandparent, pos.parent);
+        }
+    } else if (children == 1) {
+        join_with_child(pos.parent, pos.node);
+    }
+}
+
+template<typename Alphabet, typename Transform>
+std::vector<std::string> BasicRadixTrie<Alphabet, Transform>::get_suggestions(const std::string &input,
+                                                                              const int MAX_SUGGESTIONS) const {
+    // Find the closest prefix in our dictionary; if it ends inside an edge, the words below are those of the node under it.
+    const Position pos = descend(input);
+    std::vector<std::string> ret = traverse(pos.node, stored_prefix(input, pos.depth - pos.into), MAX_SUGGESTIONS);
+
+    for (auto& i : ret) {
+        Transform::restore(i);
+    }
+
+    return ret;
+}
+
+template<typename Alphabet, typename Transform>
+std::vector<std::string> BasicRadixTrie<Alphabet, Transform>::traverse(const int MAX_VEC_SIZE) const {
+    return traverse(ROOT, "", MAX_VEC_SIZE);
+}
+
+template<typename Alphabet, typename Transform>
+std::string BasicRadixTrie<Alphabet, Transform>::to_txt_data() const {
+    // The root is written as "#", like the root of a Trie.
+    std::string txt_holder = "#";
+    depth_first_search(ROOT, txt_holder);
+    ascend(txt_holder);
+    return txt_holder;
+}
+
+template<typename Alphabet, typename Transform>
+std::size_t BasicRadixTrie<Alphabet, Transform>::lookup_depth(const std::string &input) const {
+    return descend(input).hops;
+}
+
+template<typename Alphabet, typename Transform>
+std::size_t BasicRadixTrie<Alphabet, Transform>::node_num() const {
+    return nodes.size() - free_nodes.size();
+}
+
+template<typename Alphabet, typename Transform>
+std::size_t BasicRadixTrie<Alphabet, Transform>::memory_usage() const {
+    std::size_t free_block_bytes = 0;
+    for (const auto& blocks : free_blocks) {
+        free_block_bytes += blocks.capacity() * sizeof(uint32_t);
+    }
+    return sizeof(BasicRadixTrie) + nodes.capacity() * sizeof(RadixNode) + free_nodes.capacity() * sizeof(uint32_t)
+           + child_pool.capacity() * sizeof(uint32_t) + free_block_bytes + label_pool.capacity();
+}
+
+template class BasicRadixTrie<Ascii26, Identity>;
+template class BasicRadixTrie<Ascii26, Reversed>;
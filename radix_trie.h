@@ -0,0 +1,120 @@
+#ifndef OOPFINAL_RADIX_TRIE_H
+#define OOPFINAL_RADIX_TRIE_H
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "trie.h"
+
+template<typename Alphabet, typename Transform>
+class BasicRadixTrie {
+    /*
+     "RadixTrie" is a Trie whose chains of single-child nodes are collapsed into one edge, labeled with all their letters.
+     Long words mostly end in such chains : below the point where a word leaves the others, a Trie spends one node
+     (and one pointer hop on every lookup) per letter, while a RadixTrie spends one node for all of them.
+     i.e. for {"romane", "romanus", "romulus"} :
+            Trie                                RadixTrie
+            # - r - o - m - a - n - e           # - "rom" - "an" - "e"
+                            \       \                  \         \
+                             u - l - u - s              "ulus"    "us"
+                                     u - s
+     It has the same public API as Trie (push, remove, _contains_, get_suggestions, traverse, to_txt_data),
+     with the same results; to_txt_data even writes the same text, spelling every label out letter by letter.
+
+     Nodes live in one vector and point at each other by index, 16 bytes each :
+        mask        : bit c is set if there is a child starting with the letter c, like Node; END_BIT if a word ends here
+        children    : the first of the child ids, sorted by letter, in child_pool (a block per node, recycled by its size)
+        label       : the letters of the edge into this node are label_pool[label_begin, label_begin + label_len)
+     The labels of all edges share one pool of letters, in the stored order (See Transform.)
+     Splitting an edge only splits its range, so no letter is copied; joining two edges after remove() copies
+     their letters to the end of the pool, unless they already sit next to each other.
+
+     Unlike Trie, a RadixTrie does not support readers running at the same time as a writer.
+     */
+    static_assert(Alphabet::SIZE < 32, "the mask keeps the end mark in its last bit");
+    static constexpr uint32_t END_BIT = 1u << 31;
+    static constexpr uint32_t ROOT = 0;
+
+    struct RadixNode {
+        uint32_t    mask;
+        uint32_t    children;
+        uint32_t    label_begin;
+        uint32_t    label_len;
+    };
+
+    std::vector<RadixNode>  nodes;
+    std::vector<uint32_t>   free_nodes;
+    std::vector<uint32_t>   child_pool;
+    // free_blocks[n] keeps the released child blocks of n children.
+    std::array<std::vector<uint32_t>, Alphabet::SIZE + 1> free_blocks;
+    std::string             label_pool;
+
+    /*
+     Where a walk along a word stops : on the edge into 'node', after 'into' letters of its label,
+     having read 'depth' letters of the word in total. 'into' == label length means the walk stands on the node itself.
+     The parent and the grandparent of the node are kept for push and remove, which change their child blocks.
+     'hops' is the number of nodes entered below the root on the way.
+     */
+    struct Position {
+        uint32_t    node, parent, grandparent;
+        std::size_t depth, into, hops;
+    };
+
+public:
+    BasicRadixTrie();
+    explicit BasicRadixTrie(const std::vector<std::string>& vs);
+
+private:
+    [[nodiscard]] Position descend(std::string_view str) const;
+
+    [[nodiscard]] static int child_num(const RadixNode& node);
+    [[nodiscard]] bool is_end(uint32_t node) const;
+    // The id of the child of 'node' whose label starts with the letter of index 'idx', or ROOT if there is none.
+    [[nodiscard]] uint32_t find_child(uint32_t node, int idx) const;
+
+    [[nodiscard]] uint32_t new_node(uint32_t label_begin, uint32_t label_len);
+    [[nodiscard]] uint32_t new_block(int size);
+    void release_block(uint32_t block, int size);
+    // Add 'child' to the children of 'node', or put it in the place of the child with the same first letter.
+    void link(uint32_t node, uint32_t child);
+    void unlink(uint32_t node, int idx);
+    // Move the only child of 'node' up into its place, and join their labels.
+    void join_with_child(uint32_t parent, uint32_t node);
+
+    [[nodiscard]] int first_index(uint32_t node) const;
+    [[nodiscard]] std::vector<std::string> traverse(uint32_t node, std::string prefix, int MAX_VEC_SIZE) const;
+    void depth_first_search(uint32_t node, std::string& str) const;
+
+    // The first 'length' letters of 'word' in the stored order
+    [[nodiscard]] static std::string stored_prefix(std::string_view word, std::size_t length);
+
+public:
+    [[nodiscard]] bool _contains_(const std::string& input) const;
+
+    void push(const std::string& input);
+    void remove(const std::string& str);
+
+    // Same as Trie::get_suggestions
+    [[nodiscard]] std::vector<std::string> get_suggestions(const std::string& input, int MAX_SUGGESTIONS) const;
+    // At most MAX_VEC_SIZE words, as they are stored, in alphabetical order.
+    [[nodiscard]] std::vector<std::string> traverse(int MAX_VEC_SIZE) const;
+
+    // Same text as Trie::to_txt_data
+    [[nodiscard]] std::string to_txt_data() const;
+
+    // The number of nodes a lookup of the input enters below the root; a Trie enters one per letter it finds.
+    [[nodiscard]] std::size_t lookup_depth(const std::string& input) const;
+
+    // The number of nodes, including the root
+    [[nodiscard]] std::size_t node_num() const;
+    // Bytes taken by the nodes, the child blocks and the labels.
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+using RadixTrie = BasicRadixTrie<Ascii26, Identity>;
+using ReversedRadixTrie = BasicRadixTrie<Ascii26, Reversed>;
+
+#endif //OOPFINAL_RADIX_TRIE_H
@@ -0,0 +1,254 @@
+#include "sharded_dict.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <numeric>
+#include <thread>
+
+ShardedDictionary::ShardedDictionary(const std::string &path, const std::size_t _max_resident)
+        : word_num(0), max_resident(std::max<std::size_t>(_max_resident, 1)),
+          file(path, std::ios::binary), resident(SHARD_NUM), last_use(SHARD_NUM, 0) {
+    if (not file) {
+        throw mints::unable_to_open_file("Unable to open file : {name : " + path + "}");
+    }
+
+    std::error_code ec;
+    const uint64_t file_size = std::filesystem::file_size(path, ec);
+
+    Header header{};
+    index.resize(SHARD_NUM);
+    const bool read = !ec && file.read(reinterpret_cast<char*>(&header), sizeof(Header))
+                      && std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION
+                      && header.shard_num == SHARD_NUM
+                      && file.read(reinterpret_cast<char*>(index.data()), SHARD_NUM * sizeof(ShardInfo));
+    // Every shard must lie inside the file, and hold as many words as the header says in all.
+    uint64_t total = 0;
+    bool valid = read;
+    for (const auto& info : index) {
+        if (!valid) {
+            break;
+        }
+        valid = info.offset <= file_size && info.size <= file_size - info.offset && info.word_num <= info.size;
+        total += info.word_num;
+    }
+    if (!valid || total != header.word_num) {
+        throw mints::invalid_file_format("Not a sharded dictionary : {name : " + path + "}");
+    }
+    word_num = header.word_num;
+}
+
+int ShardedDictionary::shard_of(std::string_view word) {
+    int key = 0;
+    for (std::size_t i = 0; i < 2; ++i) {
+        int letter = -1;
+        if (i < word.size()) {
+            letter = Ascii26::index(word[i]);
+            if (letter == -1) {
+                return -1;
+            }
+        }
+        key = key * 27 + letter + 1;
+    }
+    return key;
+}
+
+const Trie &ShardedDictionary::shard(const int key) const {
+    last_use[key] = ++use_count;
+    if (resident[key] != nullptr) {
+        return *resident[key];
+    }
+
+    if (resident_num == max_resident) {
+        // Drop the least recently used shard; a linear scan, since it runs only when a shard is read from the file.
+        int victim = -1;
+        for (int k = 0; k < SHARD_NUM; ++k) {
+            if (resident[k] != nullptr && (victim == -1 || last_use[k] < last_use[victim])) {
+                victim = k;
+            }
+        }
+        resident[victim].reset();
+        --resident_num;
+    }
+
+    const ShardInfo& info = index[key];
+    std::string bytes(info.size, '\0');
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(info.offset));
+    if (!file.read(bytes.data(), info.size)) {
+        throw mints::invalid_file_format("Unable to read shard : {key : " + std::to_string(key) + "}");
+    }
+
+    std::vector<std::string> words;
+    words.reserve(info.word_num);
+    for (std::size_t begin = 0, end; begin < bytes.size(); begin = end + 1) {
+        end = bytes.find('\n', begin);
+        if (end == std::string::npos) {
+            end = bytes.size();
+        }
+        words.emplace_back(bytes, begin, end - begin);
+    }
+
+    resident[key] = std::make_unique<Trie>(words, std::thread::hardware_concurrency());
+    ++resident_num;
+    ++load_num;
+    return *resident[key];
+}
+
+void ShardedDictionary::compile(const std::vector<std::string> &words, const std::string &path) {
+    std::vector<std::string> sorted;
+    sorted.reserve(words.size());
+    for (const auto& word : words) {
+        if (!word.empty() && std::all_of(word.begin(), word.end(), [](char c) { return Ascii26::index(c) != -1; })) {
+            sorted.push_back(word);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    // Words sorted alphabetically are sorted by their shards too, so each shard is one run of 'sorted'.
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.shard_num = SHARD_NUM;
+    header.word_num = sorted.size();
+
+    std::vector<ShardInfo> shard_index(SHARD_NUM, ShardInfo{sizeof(Header) + SHARD_NUM * sizeof(ShardInfo), 0, 0});
+    std::string blob;
+    for (const auto& word : sorted) {
+        ShardInfo& info = shard_index[shard_of(word)];
+        if (info.word_num == 0) {
+            info.offset += blob.size();
+        }
+        ++info.word_num;
+        info.size += static_cast<uint32_t>(word.size() + 1);
+        blob += word;
+        blob += '\n';
+    }
+    // An empty shard points at the end of the file, so that every offset stays inside it.
+    for (auto& info : shard_index) {
+        if (info.word_num == 0) {
+            info.offset = sizeof(Header) + SHARD_NUM * sizeof(ShardInfo) + blob.size();
+        }
+    }
+
+    // Written aside and renamed over the old file : a ShardedDictionary opened before keeps reading the shards
+    // its index points at from the old file, rather than the bytes of other shards (See mints::replace_file.)
+    mints::replace_file(path, [&](std::ostream& ofile) {
+        ofile.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        ofile.write(reinterpret_cast<const char*>(shard_index.data()), SHARD_NUM * sizeof(ShardInfo));
+        ofile.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+    });
+}
+
+bool ShardedDictionary::is_up_to_date(const std::string &path, const std::string &source_path) {
+    std::error_code ec;
+    const auto shards_time = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return false;
+    }
+
+    Header header{};
+    std::ifstream ifile(path, std::ios::binary);
+    if (!ifile.read(reinterpret_cast<char*>(&header), sizeof(Header))
+        || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        return false;
+    }
+
+    const auto source_time = std::filesystem::last_write_time(source_path, ec);
+    // Without the source there is nothing to rebuild from, so the file is the best we have.
+    return ec || source_time <= shards_time;
+}
+
+bool ShardedDictionary::_contains_(const std::string &input) const {
+    const int key = shard_of(input);
+    if (key == -1 || index[key].word_num == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return shard(key)._contains_(input);
+}
+
+std::vector<bool> ShardedDictionary::contains_many(std::span<const std::string> inputs) const {
+    std::vector<int> keys(inputs.size());
+    std::vector<std::size_t> order(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        keys[i] = shard_of(inputs[i]);
+    }
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) {
+        return keys[a] < keys[b];
+    });
+
+    std::vector<bool> ret(inputs.size(), false);
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    for (std::size_t i : order) {
+        if (keys[i] != -1 && index[keys[i]].word_num != 0) {
+            ret[i] = shard(keys[i])._contains_(inputs[i]);
+        }
+    }
+    return ret;
+}
+
+std::vector<std::string> ShardedDictionary::get_suggestions(const std::string &input, const int MAX_SUGGESTIONS) const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    // Some word shares the first two letters of the input : the closest words are all in its shard.
+    const int key = shard_of(input);
+    if (input.size() >= 2 && key != -1 && index[key].word_num != 0) {
+        return shard(key).get_suggestions(input, MAX_SUGGESTIONS);
+    }
+
+    // Otherwise the closest words share the first letter at most : every word of that letter if there is one,
+    // or every word. The shards are in alphabetical order, so the first words are read shard by shard.
+    int first = 0, last = SHARD_NUM;
+    const int letter = input.empty() ? -1 : Ascii26::index(input[0]);
+    if (letter != -1) {
+        const int begin = 27 * (letter + 1), end = begin + 27;
+        for (int k = begin; k < end; ++k) {
+            if (index[k].word_num != 0) {
+                first = begin;
+                last = end;
+                break;
+            }
+        }
+    }
+
+    std::vector<std::string> ret;
+    for (int k = first; k < last && static_cast<int>(ret.size()) < MAX_SUGGESTIONS; ++k) {
+        if (index[k].word_num == 0) {
+            continue;
+        }
+        for (auto& word : shard(k).traverse(MAX_SUGGESTIONS - static_cast<int>(ret.size()))) {
+            ret.push_back(std::move(word));
+        }
+    }
+    return ret;
+}
+
+std::size_t ShardedDictionary::size() const {
+    return word_num;
+}
+
+std::size_t ShardedDictionary::resident_shard_num() const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return resident_num;
+}
+
+std::size_t ShardedDictionary::shard_load_num() const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return load_num;
+}
+
+std::size_t ShardedDictionary::memory_usage() const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    std::size_t bytes = sizeof(ShardedDictionary);
+    bytes += index.capacity() * sizeof(ShardInfo);
+    bytes += resident.capacity() * sizeof(std::unique_ptr<Trie>) + last_use.capacity() * sizeof(uint64_t);
+    for (const auto& trie : resident) {
+        if (trie != nullptr) {
+            bytes += trie->memory_usage();
+        }
+    }
+    return bytes;
+}
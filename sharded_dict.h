@@ -0,0 +1,104 @@
+#ifndef OOPFINAL_SHARDED_DICT_H
+#define OOPFINAL_SHARDED_DICT_H
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "mint_utils.h"
+#include "trie.h"
+
+class ShardedDictionary {
+    /*
+     "ShardedDictionary" is a dictionary file split into shards by the first two letters of the words, like the buckets
+     of Lexicon : "cat" and "cave" are in the shard "ca", and "a" in the shard "a". Opening it reads only the index of
+     the shards; a shard is read and built into a Trie the first time a lookup needs it. So a spell-check of a document
+     loads the shards of the words in the document, not the whole dictionary, which matters for a lexicon of millions of words.
+     At most 'max_resident' shards are kept built; when one more is needed, the least recently used one is dropped,
+     and read again if it is needed later. There are some hundreds of shards, so a small cap keeps the memory low even for
+     a document using words of every letter, at the cost of reading some shards more than once.
+
+     Layout :
+        Header                  (magic, version, the number of shards and of words)
+        index                   (SHARD_NUM entries : where each shard starts, its words and its bytes)
+        shards                  (for each shard, its words in alphabetical order, each followed by '\n')
+     The words come already sorted, so building a Trie from a shard is one pass (See BasicTrie::bulk_build.)
+
+     Lookups are const, but they may load and drop shards, so they take a lock : one lookup runs at a time.
+     */
+    static constexpr char       MAGIC[8] = {'M', 'I', 'N', 'T', 'S', 'H', 'R', 'D'};
+    static constexpr uint32_t   VERSION = 1;
+    // The key of a shard is 27 * (first letter + 1) + (second letter + 1), a missing second letter counting as -1.
+    static constexpr int        SHARD_NUM = 27 * 27;
+
+    struct Header {
+        char        magic[8];
+        uint32_t    version;
+        uint32_t    shard_num;
+        uint64_t    word_num;
+    };
+    struct ShardInfo {
+        uint64_t    offset;
+        uint32_t    word_num;
+        uint32_t    size;
+    };
+
+    std::vector<ShardInfo>                      index;
+    std::size_t                                 word_num;
+    std::size_t                                 max_resident;
+
+    mutable std::ifstream                       file;
+    mutable std::mutex                          cache_mutex;
+    mutable std::vector<std::unique_ptr<Trie>>  resident;
+    // last_use[key] is the lookup count when the shard was last used; the resident shard with the smallest one goes first.
+    mutable std::vector<uint64_t>               last_use;
+    mutable uint64_t                            use_count = 0;
+    mutable std::size_t                         resident_num = 0;
+    mutable std::size_t                         load_num = 0;
+
+    // The key of the shard of 'word', or -1 if its first two letters are not 'a' to 'z'.
+    [[nodiscard]] static int shard_of(std::string_view word);
+
+    // The Trie of the shard 'key', read from the file if it is not resident. The caller holds cache_mutex.
+    [[nodiscard]] const Trie& shard(int key) const;
+
+public:
+    static constexpr std::size_t DEFAULT_MAX_RESIDENT = 64;
+
+    // Read the index of a sharded dictionary. Throws if the file cannot be opened or is not a sharded dictionary.
+    explicit ShardedDictionary(const std::string& path, std::size_t _max_resident = DEFAULT_MAX_RESIDENT);
+
+    ShardedDictionary(const ShardedDictionary&) = delete;
+    ShardedDictionary& operator=(const ShardedDictionary&) = delete;
+
+    // Write the words into a sharded dictionary. Words with characters other than 'a' to 'z' are skipped, like Trie::push does.
+    // The file replaces the one at 'path' only once it is complete (See mints::replace_file.)
+    static void compile(const std::vector<std::string>& words, const std::string& path);
+
+    // Whether the file exists, has the current version, and is not older than the word list it came from.
+    [[nodiscard]] static bool is_up_to_date(const std::string& path, const std::string& source_path);
+
+    [[nodiscard]] bool _contains_(const std::string& input) const;
+    // Same as _contains_ for each input, but the inputs are looked up shard by shard, so a shard is loaded once per batch.
+    [[nodiscard]] std::vector<bool> contains_many(std::span<const std::string> inputs) const;
+
+    /*
+     Same words as Trie::get_suggestions over the whole dictionary. When the input shares its first two letters with
+     some word, they all come from its shard; otherwise the shards of its first letter (or all shards) are read in order
+     until there are MAX_SUGGESTIONS words.
+     */
+    [[nodiscard]] std::vector<std::string> get_suggestions(const std::string& input, int MAX_SUGGESTIONS) const;
+
+    [[nodiscard]] std::size_t size() const;
+    // The shards built now, and the number of times a shard was read from the file so far
+    [[nodiscard]] std::size_t resident_shard_num() const;
+    [[nodiscard]] std::size_t shard_load_num() const;
+    // Bytes taken by the index and the shards built now
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+#endif //OOPFINAL_SHARDED_DICT_H
@@ -0,0 +1,163 @@
+#include "symspell.h"
+#include "edit_distance.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+namespace {
+
+    // 64-bit FNV-1a
+    uint64_t hash_of(std::string_view str) {
+        uint64_t h = 14695981039346656037ull;
+        for (char c : str) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+}
+
+SymSpellIndex::SymSpellIndex(const std::vector<std::string> &words, int _max_distance, int _prefix_length)
+        : max_distance(_max_distance), prefix_length(_prefix_length) {
+    // Sorting first makes the ids follow the alphabetical order, so the suggestions of the same distance come out in order.
+    std::vector<std::string> sorted = words;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    // (hash of a variant, id of the word having it) for every word
+    std::vector<std::pair<uint64_t, uint32_t>> pairs;
+    for (const auto& word : sorted) {
+        if (word.empty() || !std::all_of(word.begin(), word.end(), [](char c) { return 97 <= c && c <= 122; })) {
+            continue;
+        }
+
+        const auto id = static_cast<uint32_t>(word_offsets.size());
+        word_offsets.push_back(static_cast<uint32_t>(word_pool.size()));
+        word_pool += word;
+
+        for (const auto& variant : deletion_variants(word)) {
+            pairs.emplace_back(hash_of(variant), id);
+        }
+    }
+    word_offsets.push_back(static_cast<uint32_t>(word_pool.size()));
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    // Count the distinct variants to size the table at most half full.
+    std::size_t variant_num = 0;
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+        if (i == 0 || pairs[i].first != pairs[i - 1].first) {
+            ++variant_num;
+        }
+    }
+    table.assign(std::bit_ceil(std::max<std::size_t>(variant_num * 2, 2)), Slot{0, 0, 0});
+    postings.reserve(pairs.size());
+
+    for (std::size_t i = 0; i < pairs.size(); ) {
+        const uint64_t hash = pairs[i].first;
+        const auto begin = static_cast<uint32_t>(postings.size());
+        for (; i < pairs.size() && pairs[i].first == hash; ++i) {
+            postings.push_back(pairs[i].second);
+        }
+
+        std::size_t pos = hash & (table.size() - 1);
+        while (table[pos].count != 0) {
+            pos = (pos + 1) & (table.size() - 1);
+        }
+        table[pos] = {hash, begin, static_cast<uint32_t>(postings.size()) - begin};
+    }
+}
+
+std::string_view SymSpellIndex::word_at(uint32_t id) const {
+    return std::string_view(word_pool).substr(word_offsets[id], word_offsets[id + 1] - word_offsets[id]);
+}
+
+std::vector<std::string> SymSpellIndex::deletion_variants(std::string_view word) const {
+    std::vector<std::string> variants{std::string(word.substr(0, prefix_length))};
+
+    // Variants made by d deletions come from the variants made by d - 1 deletions.
+    std::size_t from = 0;
+    for (int d = 1; d <= max_distance; ++d) {
+        const std::size_t to = variants.size();
+        for (std::size_t i = from; i < to; ++i) {
+            for (std::size_t j = 0; j < variants[i].size(); ++j) {
+                std::string variant = variants[i];
+                variant.erase(j, 1);
+                variants.push_back(std::move(variant));
+            }
+        }
+        from = to;
+    }
+
+    std::sort(variants.begin(), variants.end());
+    variants.erase(std::unique(variants.begin(), variants.end()), variants.end());
+    return variants;
+}
+
+const SymSpellIndex::Slot *SymSpellIndex::find(uint64_t hash) const {
+    for (std::size_t pos = hash & (table.size() - 1); table[pos].count != 0; pos = (pos + 1) & (table.size() - 1)) {
+        if (table[pos].hash == hash) {
+            return &table[pos];
+        }
+    }
+    return nullptr;
+}
+
+bool SymSpellIndex::_contains_(const std::string &word) const {
+    // A word is stored under its own prefix, the variant with no deletion.
+    const Slot* slot = find(hash_of(std::string_view(word).substr(0, prefix_length)));
+    if (slot == nullptr) {
+        return false;
+    }
+    for (uint32_t i = slot->begin; i < slot->begin + slot->count; ++i) {
+        if (word_at(postings[i]) == word) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> SymSpellIndex::get_suggestions(const std::string &input, const int MAX_SUGGESTIONS) const {
+    std::vector<uint32_t> candidates;
+    for (const auto& variant : deletion_variants(input)) {
+        const Slot* slot = find(hash_of(variant));
+        if (slot != nullptr) {
+            candidates.insert(candidates.end(), postings.begin() + slot->begin, postings.begin() + slot->begin + slot->count);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    // Sharing a variant only means the words may be close; check the real distance.
+    std::vector<std::pair<int, uint32_t>> found;
+    for (uint32_t id : candidates) {
+        const std::string_view word = word_at(id);
+        const auto length_gap = static_cast<int>(word.size()) - static_cast<int>(input.size());
+        if (std::abs(length_gap) > max_distance) {
+            continue;
+        }
+        const int distance = mints::edit_distance(word, input);
+        if (distance <= max_distance) {
+            found.emplace_back(distance, id);
+        }
+    }
+    std::sort(found.begin(), found.end());
+
+    std::vector<std::string> ret;
+    for (int i = 0; i < found.size() && i < MAX_SUGGESTIONS; ++i) {
+        ret.emplace_back(word_at(found[i].second));
+    }
+    return ret;
+}
+
+std::size_t SymSpellIndex::size() const {
+    return word_offsets.size() - 1;
+}
+
+std::size_t SymSpellIndex::memory_usage() const {
+    return sizeof(SymSpellIndex) + word_pool.capacity() + word_offsets.capacity() * sizeof(uint32_t)
+           + postings.capacity() * sizeof(uint32_t) + table.capacity() * sizeof(Slot);
+}
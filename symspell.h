@@ -0,0 +1,58 @@
+#ifndef OOPFINAL_SYMSPELL_H
+#define OOPFINAL_SYMSPELL_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "mint_utils.h"
+
+class SymSpellIndex {
+    /*
+     "SymSpellIndex" is a spelling index built on the 'symmetric delete' idea.
+     If two words are within k edits of each other, then deleting at most k letters from each of them gives a common string.
+     i.e. "academy" and "bcademy" both become "cademy" after one deletion.
+     So we store every word under all of its deletion variants up to k deletions, once, when the index is built.
+     A lookup makes the deletion variants of the misspelled word, which are just a handful of strings,
+     finds the words stored under each of them with one hash probe, and checks the real edit distance of those words only.
+
+     Only the first PREFIX_LENGTH letters are used to make the variants, which keeps the index small;
+     the edit distance check is always done on the whole words.
+
+     The variants themselves are not kept in memory. The hash table maps the 64-bit hash of a variant
+     to a range of 'postings', the ids of the words having that variant; the words are kept once in a word pool.
+     */
+    struct Slot {
+        uint64_t    hash;
+        uint32_t    begin;
+        uint32_t    count;  // 0 for an empty slot
+    };
+
+    int                     max_distance, prefix_length;
+    std::string             word_pool;
+    std::vector<uint32_t>   word_offsets;   // The i-th word is word_pool[word_offsets[i], word_offsets[i + 1]).
+    std::vector<uint32_t>   postings;
+    std::vector<Slot>       table;          // Open addressing with linear probing; the size is a power of 2.
+
+public:
+    // Words with non-alphabet characters are skipped, like Trie::push does.
+    explicit SymSpellIndex(const std::vector<std::string>& words, int _max_distance = 2, int _prefix_length = 7);
+
+private:
+    [[nodiscard]] std::string_view word_at(uint32_t id) const;
+    // The distinct strings made by deleting at most max_distance letters from the prefix of 'word', the prefix included.
+    [[nodiscard]] std::vector<std::string> deletion_variants(std::string_view word) const;
+    [[nodiscard]] const Slot* find(uint64_t hash) const;
+
+public:
+    [[nodiscard]] bool _contains_(const std::string& word) const;
+
+    // The words within max_distance edits of the input, the closest first, alphabetically for the same distance.
+    [[nodiscard]] std::vector<std::string> get_suggestions(const std::string& input, int MAX_SUGGESTIONS) const;
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+#endif //OOPFINAL_SYMSPELL_H
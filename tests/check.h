@@ -0,0 +1,60 @@
+#ifndef OOPFINAL_TESTS_CHECK_H
+#define OOPFINAL_TESTS_CHECK_H
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mint_utils.h"
+
+/*
+ The checks of the tests. A failed CHECK prints where it is and the test goes on, so one run shows every failure;
+ main returns checks::result(), which is 1 if any check failed, and ctest counts the test as failed.
+ */
+namespace checks {
+
+    inline int failures = 0;
+
+    inline void fail(const char* file, int line, const std::string& what) {
+        ++failures;
+        std::cerr << file << ":" << line << ": " << what << std::endl;
+    }
+
+    inline int result() {
+        if (failures > 0) {
+            std::cerr << failures << " checks failed" << std::endl;
+        }
+        return failures == 0 ? 0 : 1;
+    }
+
+    // The words of dict.txt, lowercased as main reads them
+    inline std::vector<std::string> dict_words(const std::string& path = MINTS_DICT_PATH) {
+        std::ifstream ifile(path);
+        if (not ifile) {
+            throw mints::unable_to_open_file("Unable to open file : {name : " + path + "}");
+        }
+        std::vector<std::string> words;
+        std::string line;
+        while (getline(ifile, line)) {
+            try {
+                words.push_back(mints::parse_dict_line(line).word);
+            } catch (const mints::invalid_file_format&) {}
+        }
+        return words;
+    }
+
+}
+
+#define CHECK(cond) \
+    do { if (!(cond)) checks::fail(__FILE__, __LINE__, "CHECK(" #cond ") failed"); } while (0)
+
+#define CHECK_THROWS(expr, exception) \
+    do { \
+        bool thrown_ = false; \
+        try { (void) (expr); } catch (const exception&) { thrown_ = true; } \
+        if (!thrown_) checks::fail(__FILE__, __LINE__, #expr " did not throw " #exception); \
+    } while (0)
+
+#endif //OOPFINAL_TESTS_CHECK_H
@@ -0,0 +1,129 @@
+#include "check.h"
+#include "aho_corasick.h"
+#include "holders.h"
+
+#include <random>
+
+namespace {
+
+    using Match = AhoCorasick::Match;
+
+    char lower(char c) {
+        return 'A' <= c && c <= 'Z' ? static_cast<char>(c + 32) : c;
+    }
+
+    // Every occurrence by std::string::find, one pattern at a time, sorted as for_each_match reports them
+    std::vector<Match> find_each(const std::vector<std::string>& patterns, std::string text, bool ignore_case) {
+        std::vector<Match> ret;
+        if (ignore_case) {
+            std::transform(text.begin(), text.end(), text.begin(), lower);
+        }
+        for (uint32_t id = 0; id < patterns.size(); ++id) {
+            std::string pattern = patterns[id];
+            if (ignore_case) {
+                std::transform(pattern.begin(), pattern.end(), pattern.begin(), lower);
+            }
+            // A pattern given twice is reported with its first index.
+            bool seen = false;
+            for (uint32_t before = 0; before < id; ++before) {
+                std::string other = patterns[before];
+                if (ignore_case) {
+                    std::transform(other.begin(), other.end(), other.begin(), lower);
+                }
+                seen = seen || other == pattern;
+            }
+            for (std::size_t pos = text.find(pattern); !seen && pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+                ret.push_back(Match{pos, id});
+            }
+        }
+        std::sort(ret.begin(), ret.end(), [&patterns](const Match& lhs, const Match& rhs) {
+            const std::size_t lhs_end = lhs.pos + patterns[lhs.pattern].size();
+            const std::size_t rhs_end = rhs.pos + patterns[rhs.pattern].size();
+            return lhs_end != rhs_end ? lhs_end < rhs_end : lhs.pos < rhs.pos;
+        });
+        return ret;
+    }
+
+    // From the left, the longest occurrence at the leftmost place, then the same after its end
+    std::vector<Match> leftmost_longest(const std::vector<Match>& all, const std::vector<std::string>& patterns) {
+        std::vector<Match> sorted = all;
+        std::sort(sorted.begin(), sorted.end(), [&patterns](const Match& lhs, const Match& rhs) {
+            return lhs.pos != rhs.pos ? lhs.pos < rhs.pos : patterns[lhs.pattern].size() > patterns[rhs.pattern].size();
+        });
+        std::vector<Match> ret;
+        std::size_t next = 0;
+        for (const Match& match : sorted) {
+            if (match.pos >= next) {
+                ret.push_back(match);
+                next = match.pos + patterns[match.pattern].size();
+            }
+        }
+        return ret;
+    }
+
+    void test_examples() {
+        const AhoCorasick he({"he", "she", "hers", "his"});
+        CHECK(he.find_all("ushers") == std::vector<Match>({{1, 1}, {2, 0}, {2, 2}}));
+        CHECK(he.find_leftmost_longest("ushers") == std::vector<Match>({{1, 1}}));
+        CHECK(he.find_all("").empty());
+        CHECK(he.pattern_num() == 4);
+
+        const AhoCorasick pets({"cat", "dog"});
+        CHECK(pets.replace_all("a cat and a dog", {"dog", "cat"}) == "a dog and a cat");
+        CHECK(pets.replace_all("no pets", {"dog", "cat"}) == "no pets");
+        CHECK_THROWS(pets.replace_all("a cat", {"dog"}), mints::input_out_of_range);
+
+        const AhoCorasick any_case({"Hello world", "C++"}, true);
+        CHECK(any_case.find_all("hello WORLD in c++!") == std::vector<Match>({{0, 0}, {15, 1}}));
+        CHECK(AhoCorasick({"Hello"}).find_all("hello").empty());
+
+        CHECK_THROWS(AhoCorasick({"ok", ""}), mints::invalid_pattern);
+    }
+
+    // Random small alphabets give many overlaps; the automaton must agree with a find per pattern every time.
+    void test_against_find() {
+        std::mt19937 rng(7);
+        auto random_string = [&rng](std::size_t max_len) {
+            std::string ret(1 + rng() % max_len, 'a');
+            for (char& c : ret) {
+                c = "abAB c"[rng() % 6];
+            }
+            return ret;
+        };
+        for (int round = 0; round < 2000; ++round) {
+            std::vector<std::string> patterns(1 + rng() % 6);
+            for (auto& pattern : patterns) {
+                pattern = random_string(4);
+            }
+            const std::string text = random_string(60);
+            for (const bool ignore_case : {false, true}) {
+                const AhoCorasick automaton(patterns, ignore_case);
+                const std::vector<Match> expected = find_each(patterns, text, ignore_case);
+                CHECK(automaton.find_all(text) == expected);
+                CHECK(automaton.find_leftmost_longest(text) == leftmost_longest(expected, patterns));
+            }
+        }
+    }
+
+    // A StringHolder rewrites its text once, with every occurrence replaced, and counts them.
+    void test_string_holder() {
+        StringHolder holder({"title", "the cat sat on the mat"});
+        const AhoCorasick patterns({"the", "at"});
+        CHECK(holder.find_all(patterns).size() == 5);
+        CHECK(holder.replace_all(patterns, {"a", "og"}) == 5);
+
+        std::ostringstream printed;
+        std::streambuf* const cout_buf = std::cout.rdbuf(printed.rdbuf());
+        holder.print();
+        std::cout.rdbuf(cout_buf);
+        CHECK(printed.str() == "a cog sog on a mog\n\n");
+    }
+
+}
+
+int main() {
+    test_examples();
+    test_against_find();
+    test_string_holder();
+    return checks::result();
+}
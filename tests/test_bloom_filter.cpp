@@ -0,0 +1,92 @@
+#include "check.h"
+#include "bloom_filter.h"
+#include "lexicon.h"
+
+#include <cmath>
+#include <random>
+
+namespace {
+
+    // Strings of random letters, none of which is a word of the dictionary
+    std::vector<std::string> strangers(const Lexicon& lexicon, std::size_t count) {
+        std::mt19937 rng(17);
+        std::vector<std::string> ret;
+        while (ret.size() < count) {
+            std::string word(5 + rng() % 6, 'a');
+            for (char& c : word) {
+                c = static_cast<char>('a' + rng() % 26);
+            }
+            if (!lexicon._contains_(word)) {
+                ret.push_back(word);
+            }
+        }
+        return ret;
+    }
+
+    // Every word put in passes, and the share of the others which pass is about the rate the filter was made for.
+    void test_false_positive_rate() {
+        const std::vector<std::string> words = checks::dict_words();
+        const Lexicon lexicon(words);
+        const std::vector<std::string> others = strangers(lexicon, 200000);
+
+        for (double rate : {0.01, 0.001}) {
+            BloomFilter filter = BloomFilter::for_false_positive_rate(lexicon.size(), rate);
+            for (uint32_t id = 0; id < lexicon.size(); ++id) {
+                filter.insert(lexicon.word(id));
+            }
+            CHECK(filter.size() == lexicon.size());
+            for (uint32_t id = 0; id < lexicon.size(); ++id) {
+                CHECK(filter.may_contain(lexicon.word(id)));
+            }
+
+            std::size_t passed = 0;
+            for (const auto& word : others) {
+                passed += filter.may_contain(word);
+            }
+            const double measured = static_cast<double>(passed) / static_cast<double>(others.size());
+            CHECK(measured < rate * 1.5);
+            CHECK(std::abs(filter.false_positive_rate() - rate) < rate * 0.3);
+            CHECK(std::abs(measured - filter.false_positive_rate()) < rate * 0.3);
+        }
+        CHECK(BloomFilter::bits_per_key_for(0.001) > BloomFilter::bits_per_key_for(0.01));
+    }
+
+    void test_memory_budget() {
+        CHECK(BloomFilter::for_memory(64 * 100).memory_usage() <= 64 * 100 + sizeof(BloomFilter));
+        // At least one block, however small the budget
+        BloomFilter tiny = BloomFilter::for_memory(1);
+        tiny.insert("word");
+        CHECK(tiny.may_contain("word"));
+    }
+
+    // A filter in front of a Lexicon changes no answer, only how fast the misses come.
+    void test_lexicon_filter() {
+        Lexicon lexicon(checks::dict_words());
+        const std::vector<std::string> others = strangers(lexicon, 20000);
+        std::vector<std::string> queries = others;
+        for (uint32_t id = 0; id < lexicon.size(); ++id) {
+            queries.emplace_back(lexicon.word(id));
+        }
+        const std::vector<bool> without = lexicon.contains_many(queries);
+
+        CHECK(lexicon.get_filter() == nullptr);
+        lexicon.build_filter(0.01);
+        CHECK(lexicon.get_filter() != nullptr);
+        CHECK(lexicon.contains_many(queries) == without);
+
+        lexicon.build_filter_within(1024);
+        CHECK(lexicon.get_filter()->memory_usage() <= 1024 + sizeof(BloomFilter));
+        CHECK(lexicon.contains_many(queries) == without);
+
+        lexicon.drop_filter();
+        CHECK(lexicon.get_filter() == nullptr);
+    }
+
+}
+
+int main() {
+    test_false_positive_rate();
+    test_memory_budget();
+    test_lexicon_filter();
+    return checks::result();
+}
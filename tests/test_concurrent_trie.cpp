@@ -0,0 +1,82 @@
+#include "check.h"
+#include "trie.h"
+
+#include <atomic>
+#include <thread>
+
+namespace {
+
+    bool in_order(const std::vector<std::string>& words) {
+        return std::is_sorted(words.begin(), words.end()) && std::adjacent_find(words.begin(), words.end()) == words.end();
+    }
+
+    /*
+     Readers look up the words that stay in the Trie while a writer pushes and removes the others over and over.
+     A reader must always find the words that stay, never find a word that was never pushed,
+     and always see the words in order; the checks are counted in atomics, since CHECK is not thread safe.
+     */
+    void test_readers_during_writes() {
+        std::vector<std::string> words = checks::dict_words();
+        std::erase_if(words, [](const std::string& word) {
+            return word.empty() || !std::all_of(word.begin(), word.end(), [](char c) { return 'a' <= c && c <= 'z'; });
+        });
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        std::vector<std::string> staying, coming_and_going;
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            (i % 2 == 0 ? staying : coming_and_going).push_back(words[i]);
+        }
+
+        Trie trie(staying);
+        trie.enable_concurrent_readers();
+        const std::size_t bytes = trie.memory_usage();
+
+        std::atomic<bool> done = false;
+        std::atomic<int> lost = 0, invented = 0, unordered = 0, lookups = 0;
+        auto read = [&](std::size_t first) {
+            for (std::size_t i = first; !done.load(); i = (i + 7) % staying.size()) {
+                if (!trie._contains_(staying[i])) {
+                    ++lost;
+                }
+                if (trie._contains_(staying[i] + "qqzx")) {
+                    ++invented;
+                }
+                if (!in_order(trie.get_suggestions(staying[i].substr(0, 2), 50))) {
+                    ++unordered;
+                }
+                ++lookups;
+            }
+        };
+
+        std::vector<std::thread> readers;
+        for (std::size_t r = 0; r < 3; ++r) {
+            readers.emplace_back(read, r * 1000);
+        }
+        for (int round = 0; round < 5; ++round) {
+            for (const auto& word : coming_and_going) {
+                trie.push(word);
+            }
+            for (const auto& word : coming_and_going) {
+                trie.remove(word);
+            }
+        }
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        CHECK(lookups > 0);
+        CHECK(lost == 0);
+        CHECK(invented == 0);
+        CHECK(unordered == 0);
+        CHECK(trie.traverse(static_cast<int>(words.size())) == staying);
+        // The retired blocks and nodes are recycled, so the rounds do not pile up memory.
+        CHECK(trie.memory_usage() < bytes * 3);
+    }
+
+}
+
+int main() {
+    test_readers_during_writes();
+    return checks::result();
+}
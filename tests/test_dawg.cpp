@@ -0,0 +1,56 @@
+#include "check.h"
+#include "dawg.h"
+#include "trie.h"
+
+#include <random>
+
+namespace {
+
+    // A Dawg answers as the Trie of the same words, with far fewer states.
+    void test_same_as_trie() {
+        const std::vector<std::string> words = checks::dict_words();
+        const Dawg dawg(words);
+        const Trie trie(words);
+
+        std::mt19937 rng(12);
+        std::vector<std::string> queries = {"", "a", "zz", "Apple", "a-b"};
+        for (int i = 0; i < 3000; ++i) {
+            std::string word = words[rng() % words.size()];
+            if (!word.empty() && rng() % 2 == 0) {
+                word[rng() % word.size()] = static_cast<char>('a' + rng() % 26);
+            }
+            queries.push_back(word);
+        }
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            CHECK(dawg._contains_(queries[i]) == trie._contains_(queries[i]));
+            CHECK(dawg.get_suggestions(queries[i], 10) == trie.get_suggestions(queries[i], 10));
+            if (i < 100) {
+                CHECK(dawg.get_suggestions_within(queries[i], 2, 10) == trie.get_suggestions_within(queries[i], 2, 10));
+            }
+        }
+        const int all = static_cast<int>(words.size());
+        CHECK(dawg.traverse(all) == trie.traverse(all));
+        CHECK(dawg.traverse(INT32_MAX) == trie.traverse(all));
+        CHECK(dawg.node_num() * 3 < trie.node_num());
+        CHECK(dawg.memory_usage() * 3 < trie.memory_usage());
+    }
+
+    // The example of dawg.h : {"tap", "taps", "top", "tops"} share "t" in front and "p", "s" behind.
+    void test_shared_suffixes() {
+        const Dawg dawg({"tops", "tap", "top", "taps", "Tip", "t-p"});
+        CHECK(dawg.traverse(10) == std::vector<std::string>({"tap", "taps", "top", "tops"}));
+        CHECK(dawg._contains_("top"));
+        CHECK(!dawg._contains_("to"));
+        CHECK(!dawg._contains_("tip"));
+        // The start and 4 states below it, as the trie has 7 : the transitions are 't', 'a', 'o', 'p' and 's'.
+        CHECK(dawg.node_num() == 1 + 4);
+        CHECK(dawg.edge_num() == 5);
+    }
+
+}
+
+int main() {
+    test_same_as_trie();
+    test_shared_suffixes();
+    return checks::result();
+}
@@ -0,0 +1,141 @@
+#include "check.h"
+#include "dict_image.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+    // The header of an image as dict_image.h lays it out
+    struct Header {
+        char        magic[8];
+        uint32_t    version;
+        uint32_t    reserved;
+        uint64_t    word_num;
+        uint64_t    pool_size;
+        uint64_t    offsets_offset;
+        uint64_t    by_suffix_offset;
+        uint64_t    pool_offset;
+        uint64_t    weights_offset;
+    };
+
+    const std::string IMAGE = (std::filesystem::temp_directory_path() / "oopfinal_test_dict.img").string();
+    const std::string BROKEN = (std::filesystem::temp_directory_path() / "oopfinal_test_broken.img").string();
+
+    std::string read_file(const std::string& path) {
+        std::ifstream ifile(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(ifile), std::istreambuf_iterator<char>()};
+    }
+
+    void write_file(const std::string& path, const std::string& bytes) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // Put 'value' at 'pos' of a copy of the image, write it, and return whether loading it throws invalid_file_format.
+    template<typename T>
+    bool rejects(const std::string& image, std::size_t pos, T value) {
+        std::string bytes = image;
+        std::memcpy(bytes.data() + pos, &value, sizeof(T));
+        write_file(BROKEN, bytes);
+        try {
+            DictionaryImage broken(BROKEN);
+        } catch (const mints::invalid_file_format&) {
+            return true;
+        }
+        return false;
+    }
+
+    void test_round_trip() {
+        const std::vector<std::string> words = checks::dict_words();
+        std::vector<uint32_t> weights;
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            weights.push_back(static_cast<uint32_t>(i % 97));
+        }
+        DictionaryImage::compile(words, weights, IMAGE);
+        CHECK(DictionaryImage::is_up_to_date(IMAGE, MINTS_DICT_PATH));
+
+        const Lexicon owned(words, weights);
+        DictionaryImage image(IMAGE);
+        // The filter is made over the mapped words, as Listener does when it loads the dictionary.
+        image.build_filter(0.01);
+        const Lexicon& mapped = image.lexicon();
+        CHECK(mapped.get_filter() != nullptr);
+        CHECK(mapped.size() == owned.size());
+        CHECK(mapped.has_weights());
+        CHECK(mapped.traverse((int) owned.size()) == owned.traverse((int) owned.size()));
+        CHECK(mapped.contains_many(words) == owned.contains_many(words));
+        for (const char* query : {"the", "brwn", "recieve", "zzz", "a"}) {
+            CHECK(mapped._contains_(query) == owned._contains_(query));
+            CHECK(mapped.get_suggestions_by_prefix(query, 10) == owned.get_suggestions_by_prefix(query, 10));
+            CHECK(mapped.get_suggestions_by_suffix(query, 10) == owned.get_suggestions_by_suffix(query, 10));
+            CHECK(mapped.get_top_suggestions(query, 10) == owned.get_top_suggestions(query, 10));
+        }
+    }
+
+    // Compiling again replaces the file rather than rewriting it : a mapping of the old image keeps reading the old words.
+    void test_recompile_keeps_mappings() {
+        DictionaryImage::compile({"bad", "bed", "bid"}, IMAGE);
+        const DictionaryImage old_image(IMAGE);
+        DictionaryImage::compile({"cab", "cabin", "cobalt", "cube", "cupboard"}, IMAGE);
+        const DictionaryImage new_image(IMAGE);
+
+        CHECK(old_image.lexicon().traverse(10) == std::vector<std::string>({"bad", "bed", "bid"}));
+        CHECK(old_image.lexicon()._contains_("bed"));
+        CHECK(!old_image.lexicon()._contains_("cabin"));
+        CHECK(new_image.lexicon().size() == 5);
+        CHECK(new_image.lexicon()._contains_("cupboard"));
+        // No temporary file is left next to the image.
+        for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::path(IMAGE).parent_path())) {
+            CHECK(!entry.path().filename().string().starts_with("oopfinal_test_dict.img.tmp"));
+        }
+    }
+
+    // A truncated or corrupted image is refused when it is mapped, never read out of bounds later.
+    void test_broken_images() {
+        DictionaryImage::compile({"bad", "bed", "bid", "cab", "cabin"}, IMAGE);
+        const std::string image = read_file(IMAGE);
+        Header header{};
+        std::memcpy(&header, image.data(), sizeof(Header));
+        CHECK(header.word_num == 5);
+
+        CHECK_THROWS(DictionaryImage("/nonexistent/dict.img"), mints::unable_to_open_file);
+        write_file(BROKEN, image.substr(0, sizeof(Header) - 1));
+        CHECK_THROWS(DictionaryImage(BROKEN), mints::invalid_file_format);
+        write_file(BROKEN, image.substr(0, image.size() - 8));
+        CHECK_THROWS(DictionaryImage(BROKEN), mints::invalid_file_format);
+
+        CHECK(rejects(image, 0, 'X'));
+        CHECK(rejects(image, offsetof(Header, version), uint32_t{99}));
+        CHECK(rejects(image, offsetof(Header, word_num), uint64_t{1} << 40));
+        CHECK(rejects(image, offsetof(Header, pool_offset), header.pool_offset + 1));
+
+        // offsets : out of the pool, going backwards, or not starting at 0
+        CHECK(rejects(image, header.offsets_offset + 5 * sizeof(uint32_t), uint32_t{1000}));
+        CHECK(rejects(image, header.offsets_offset + 2 * sizeof(uint32_t), uint32_t{1}));
+        CHECK(rejects(image, header.offsets_offset, uint32_t{1}));
+        // by_suffix : an id out of range, or an id twice
+        CHECK(rejects(image, header.by_suffix_offset, uint32_t{5}));
+        CHECK(rejects(image, header.by_suffix_offset, uint32_t{0}) || rejects(image, header.by_suffix_offset, uint32_t{1}));
+        // pool : a letter out of 'a' to 'z', or words out of order
+        CHECK(rejects(image, header.pool_offset, 'A'));
+        CHECK(rejects(image, header.pool_offset, 'z'));
+
+        // The untouched image still loads.
+        write_file(BROKEN, image);
+        const DictionaryImage fine(BROKEN);
+        CHECK(fine.lexicon()._contains_("cabin"));
+
+        std::filesystem::remove(IMAGE);
+        std::filesystem::remove(BROKEN);
+        CHECK(!DictionaryImage::is_up_to_date(IMAGE, MINTS_DICT_PATH));
+    }
+
+}
+
+int main() {
+    test_round_trip();
+    test_recompile_keeps_mappings();
+    test_broken_images();
+    return checks::result();
+}
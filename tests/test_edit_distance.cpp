@@ -0,0 +1,80 @@
+#include "check.h"
+#include "edit_distance.h"
+#include "trie.h"
+
+#include <random>
+#include <set>
+
+namespace {
+
+    void test_edit_distance() {
+        CHECK(mints::edit_distance("", "") == 0);
+        CHECK(mints::edit_distance("", "abc") == 3);
+        CHECK(mints::edit_distance("abc", "") == 3);
+        CHECK(mints::edit_distance("kitten", "sitting") == 3);
+        CHECK(mints::edit_distance("teh", "the") == 1);
+        CHECK(mints::edit_distance("abcd", "acbd") == 1);
+        // An optimal string alignment edits no substring twice, so "ca" is 3 away from "abc", not 2.
+        CHECK(mints::edit_distance("ca", "abc") == 3);
+        CHECK(mints::edit_distance("flaw", "lawn") == 2);
+    }
+
+    // The trie walk finds exactly the words a scan of the whole list finds, in the same order.
+    void test_same_as_scan() {
+        const std::vector<std::string> words = checks::dict_words();
+        const Trie trie(words);
+        const std::set<std::string> dictionary(words.begin(), words.end());
+
+        std::mt19937 rng(6);
+        std::vector<std::string> queries = {"", "a", "teh", "recieve", "zzzzzz"};
+        for (int i = 0; i < 40; ++i) {
+            std::string word = words[rng() % words.size()];
+            if (!word.empty()) {
+                word[rng() % word.size()] = static_cast<char>('a' + rng() % 26);
+            }
+            queries.push_back(word);
+        }
+
+        for (const auto& query : queries) {
+            // The words within 2 edits, in alphabetical order, with their distances
+            std::vector<std::pair<std::string, int>> near;
+            for (const auto& word : dictionary) {
+                if (word.empty() || !std::all_of(word.begin(), word.end(), [](char c) { return 'a' <= c && c <= 'z'; })) {
+                    continue;
+                }
+                const int distance = mints::edit_distance(query, word);
+                if (distance <= 2) {
+                    near.emplace_back(word, distance);
+                }
+            }
+            for (int k = 0; k <= 2; ++k) {
+                std::vector<std::pair<std::string, int>> expected;
+                std::copy_if(near.begin(), near.end(), std::back_inserter(expected), [k](const auto& found) {
+                    return found.second <= k;
+                });
+                std::stable_sort(expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) {
+                    return lhs.second < rhs.second;
+                });
+                CHECK(mints::search_within_distance(trie, query, k) == expected);
+            }
+        }
+    }
+
+    void test_suggestions_within() {
+        Trie trie;
+        for (const char* word : {"the", "then", "them", "they", "tea", "ten", "other"}) {
+            trie.push(word);
+        }
+        CHECK(trie.get_suggestions_within("teh", 1, 10) == std::vector<std::string>({"tea", "ten", "the"}));
+        CHECK(trie.get_suggestions_within("teh", 2, 2) == std::vector<std::string>({"tea", "ten"}));
+        CHECK(trie.get_suggestions_within("xyz", 2, 10).empty());
+    }
+
+}
+
+int main() {
+    test_edit_distance();
+    test_same_as_scan();
+    test_suggestions_within();
+    return checks::result();
+}
@@ -0,0 +1,64 @@
+#include "check.h"
+#include "frozen_trie.h"
+#include "trie.h"
+
+#include <random>
+
+namespace {
+
+    std::vector<std::string> queries(const std::vector<std::string>& words) {
+        std::mt19937 rng(3);
+        std::vector<std::string> ret = {"", "a", "zz", "Apple", "a-b", "qqqq"};
+        for (int i = 0; i < 2000; ++i) {
+            std::string word = words[rng() % words.size()];
+            if (!word.empty() && rng() % 2 == 0) {
+                word[rng() % word.size()] = static_cast<char>('a' + rng() % 26);
+            }
+            ret.push_back(word);
+        }
+        return ret;
+    }
+
+    // A FrozenTrie answers every question as the Trie it is frozen from.
+    template<typename Transform>
+    void test_same_as_trie() {
+        const std::vector<std::string> words = checks::dict_words();
+        const BasicTrie<Ascii26, Transform> trie(words);
+        const FrozenTrie frozen = trie.freeze();
+        const std::vector<std::string> qs = queries(words);
+
+        const std::vector<bool> found = frozen.contains_many(qs);
+        for (std::size_t i = 0; i < qs.size(); ++i) {
+            CHECK(frozen._contains_(qs[i]) == trie._contains_(qs[i]));
+            CHECK(found[i] == trie._contains_(qs[i]));
+            CHECK(frozen.get_suggestions(qs[i], 10) == trie.get_suggestions(qs[i], 10));
+        }
+        for (std::size_t i = 0; i < 100; ++i) {
+            CHECK(frozen.get_suggestions_within(qs[i], 2, 10) == trie.get_suggestions_within(qs[i], 2, 10));
+        }
+        const int all = static_cast<int>(words.size());
+        CHECK(frozen.traverse(all) == trie.traverse(all));
+        // A count far over the words reserves no more than Node::RESERVE_LIMIT up front.
+        CHECK(frozen.traverse(INT32_MAX) == trie.traverse(all));
+        // The double array of a dictionary packs without many holes.
+        CHECK(frozen.size() >= trie.node_num());
+        CHECK(frozen.size() < trie.node_num() * 11 / 10);
+    }
+
+    void test_empty_trie() {
+        const Trie trie;
+        const FrozenTrie frozen = trie.freeze();
+        CHECK(!frozen._contains_(""));
+        CHECK(!frozen._contains_("a"));
+        CHECK(frozen.traverse(10).empty());
+        CHECK(frozen.get_suggestions("abc", 10).empty());
+    }
+
+}
+
+int main() {
+    test_same_as_trie<Identity>();
+    test_same_as_trie<Reversed>();
+    test_empty_trie();
+    return checks::result();
+}
@@ -0,0 +1,103 @@
+#include "check.h"
+#include "generator.h"
+#include "lexicon.h"
+#include "trie.h"
+
+#include <ranges>
+
+namespace {
+
+    mints::Generator<int> counting(int n, int& steps) {
+        for (int i = 0; i < n; ++i) {
+            ++steps;
+            co_yield i;
+        }
+    }
+
+    mints::Generator<int> throwing_after(int n) {
+        for (int i = 0; i < n; ++i) {
+            co_yield i;
+        }
+        throw mints::unpoppable("nothing left");
+    }
+
+    // The body runs only as far as the caller reads, and a yielded value refers to the operand of co_yield.
+    void test_lazy() {
+        int steps = 0;
+        mints::Generator<int> gen = counting(1000, steps);
+        CHECK(steps == 0);
+        std::vector<int> read;
+        for (int i : gen | std::views::take(3)) {
+            read.push_back(i);
+        }
+        CHECK(read == std::vector<int>({0, 1, 2}));
+        CHECK(steps <= 4);
+
+        int all_steps = 0;
+        int sum = 0;
+        for (int i : counting(10, all_steps)) {
+            sum += i;
+        }
+        CHECK(sum == 45);
+        CHECK(all_steps == 10);
+
+        int none = 0, none_read = 0;
+        for (int i : counting(0, none)) {
+            none_read += 1 + i;
+        }
+        CHECK(none_read == 0);
+    }
+
+    void test_exception() {
+        std::vector<int> read;
+        CHECK_THROWS([&read] {
+            for (int i : throwing_after(2)) {
+                read.push_back(i);
+            }
+        }(), mints::unpoppable);
+        CHECK(read == std::vector<int>({0, 1}));
+        CHECK_THROWS(throwing_after(0).begin(), mints::unpoppable);
+    }
+
+    // The lazy suggestions are the words of the copying ones, in the same order, and may be left at any point.
+    template<typename Transform>
+    void test_trie_suggestions() {
+        const std::vector<std::string> words = checks::dict_words();
+        const BasicTrie<Ascii26, Transform> trie(words);
+        for (const char* input : {"", "a", "pre", "tion", "zzz", "a-b", "internationalization"}) {
+            std::vector<std::string> lazy;
+            for (std::string_view word : trie.suggestions(input)) {
+                lazy.emplace_back(word);
+                if (lazy.size() == 100) {
+                    break;
+                }
+            }
+            CHECK(lazy == trie.get_suggestions(input, 100));
+        }
+    }
+
+    void test_lexicon_suggestions() {
+        const Lexicon lexicon(checks::dict_words());
+        for (const char* input : {"", "a", "pre", "tion", "zzz"}) {
+            std::vector<std::string> by_prefix, by_suffix;
+            for (std::string_view word : lexicon.suggestions_by_prefix(input) | std::views::take(50)) {
+                by_prefix.emplace_back(word);
+            }
+            for (std::string_view word : lexicon.suggestions_by_suffix(input) | std::views::take(50)) {
+                by_suffix.emplace_back(word);
+            }
+            CHECK(by_prefix == lexicon.get_suggestions_by_prefix(input, 50));
+            CHECK(by_suffix == lexicon.get_suggestions_by_suffix(input, 50));
+        }
+    }
+
+}
+
+int main() {
+    test_lazy();
+    test_exception();
+    test_trie_suggestions<Identity>();
+    test_trie_suggestions<Reversed>();
+    test_lexicon_suggestions();
+    return checks::result();
+}
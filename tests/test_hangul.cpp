@@ -0,0 +1,84 @@
+#include "check.h"
+#include "hangul.h"
+
+#include <random>
+#include <set>
+
+namespace {
+
+    std::string utf8(char32_t cp) {
+        std::string ret;
+        ret += static_cast<char>(0xE0 | cp >> 12);
+        ret += static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+        ret += static_cast<char>(0x80 | (cp & 0x3F));
+        return ret;
+    }
+
+    // Every syllable, and random words mixing syllables with 'a' to 'z', come back from their letters as they were.
+    void test_round_trip() {
+        for (char32_t cp = 0xAC00; cp <= 0xD7A3; ++cp) {
+            const std::string syllable = utf8(cp);
+            CHECK(hangul::from_letters(hangul::to_letters(syllable)) == syllable);
+            CHECK(hangul::length_at(syllable, 0) == 3);
+        }
+        std::mt19937 rng(9);
+        for (int round = 0; round < 20000; ++round) {
+            std::string word;
+            for (int i = 1 + static_cast<int>(rng() % 6); i > 0; --i) {
+                word += rng() % 4 == 0 ? std::string(1, static_cast<char>('a' + rng() % 26)) : utf8(0xAC00 + rng() % 11172);
+            }
+            CHECK(hangul::from_letters(hangul::to_letters(word)) == word);
+        }
+
+        CHECK(hangul::to_letters("한국").size() == 6);
+        CHECK(hangul::to_letters("각까") != hangul::to_letters("갂가"));
+        // A prefix ending inside a syllable comes back as loose jamo.
+        CHECK(hangul::from_letters(hangul::to_letters("한국").substr(0, 4)) == "한ㄱ");
+        CHECK(hangul::from_letters(hangul::to_letters("ㄱ")) == "ㄱ");
+
+        CHECK(hangul::length_at("a한", 0) == 0);
+        CHECK(hangul::length_at("a한", 1) == 3);
+        CHECK(hangul::length_at("ㅏ", 0) == 3);
+        CHECK(hangul::length_at("é", 0) == 0);
+        CHECK(hangul::length_at("\xEA\xB0", 0) == 0);
+    }
+
+    // A HangulTrie finds the words of a set and no others, and suggests by jamo.
+    void test_hangul_trie() {
+        std::mt19937 rng(10);
+        std::vector<std::string> words;
+        for (int i = 0; i < 5000; ++i) {
+            std::string word;
+            for (int j = 1 + static_cast<int>(rng() % 3); j > 0; --j) {
+                word += utf8(0xAC00 + rng() % 11172);
+            }
+            words.push_back(word);
+        }
+        const HangulTrie trie(words);
+        const std::set<std::string> set(words.begin(), words.end());
+        CHECK(trie.traverse((int) words.size()).size() == set.size());
+        for (int i = 0; i < 20000; ++i) {
+            std::string word = words[rng() % words.size()];
+            if (rng() % 2 == 0) {
+                word = utf8(0xAC00 + rng() % 11172) + word.substr(3);
+            }
+            CHECK(trie._contains_(word) == set.contains(word));
+        }
+
+        const HangulTrie small(std::vector<std::string>{"한국", "한국어", "한글", "학교", "apple"});
+        CHECK(small._contains_("한글"));
+        CHECK(small._contains_("apple"));
+        CHECK(!small._contains_("한"));
+        CHECK(small.get_suggestions("한국사", 10) == std::vector<std::string>({"한국", "한국어"}));
+        // One wrong jamo is one edit : 한굴 is ㅎㅏㄴㄱㅜㄹ, and 한글 is ㅎㅏㄴㄱㅡㄹ.
+        const std::vector<std::string> within = small.get_suggestions_within("한굴", 1, 10);
+        CHECK(std::find(within.begin(), within.end(), "한글") != within.end());
+    }
+
+}
+
+int main() {
+    test_round_trip();
+    test_hangul_trie();
+    return checks::result();
+}
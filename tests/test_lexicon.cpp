@@ -0,0 +1,236 @@
+#include "check.h"
+#include "lexicon.h"
+#include "trie.h"
+
+#include <map>
+#include <random>
+#include <set>
+
+namespace {
+
+    std::vector<std::string> queries(const std::vector<std::string>& words) {
+        std::mt19937 rng(11);
+        std::vector<std::string> ret = {"", "a", "zz", "Apple", "a-b", "qqqq"};
+        for (int i = 0; i < 3000; ++i) {
+            std::string word = words[rng() % words.size()];
+            if (!word.empty() && rng() % 2 == 0) {
+                word[rng() % word.size()] = static_cast<char>('a' + rng() % 26);
+            }
+            ret.push_back(word);
+        }
+        return ret;
+    }
+
+    // One Lexicon answers as the forward and the reversed Trie it replaces.
+    void test_same_as_tries() {
+        const std::vector<std::string> words = checks::dict_words();
+        const Lexicon lexicon(words);
+        const Trie trie(words);
+        const ReversedTrie reversed(words);
+        const std::vector<std::string> qs = queries(words);
+
+        const std::vector<bool> found = lexicon.contains_many(qs);
+        for (std::size_t i = 0; i < qs.size(); ++i) {
+            CHECK(lexicon._contains_(qs[i]) == trie._contains_(qs[i]));
+            CHECK(found[i] == trie._contains_(qs[i]));
+            CHECK(lexicon.get_suggestions_by_prefix(qs[i], 10) == trie.get_suggestions(qs[i], 10));
+            CHECK(lexicon.get_suggestions_by_suffix(qs[i], 10) == reversed.get_suggestions(qs[i], 10));
+        }
+        for (std::size_t i = 0; i < 100; ++i) {
+            CHECK(lexicon.get_suggestions_within(qs[i], 2, 10) == trie.get_suggestions_within(qs[i], 2, 10));
+        }
+        const int all = static_cast<int>(words.size());
+        CHECK(lexicon.traverse(all) == trie.traverse(all));
+        CHECK(lexicon.size() == trie.traverse(all).size());
+    }
+
+    // The closeness of a word to the input : the letters it shares at the front plus those it shares at the back
+    std::size_t closeness(std::string_view word, std::string_view input) {
+        std::size_t prefix = 0, suffix = 0;
+        while (prefix < word.size() && prefix < input.size() && word[prefix] == input[prefix]) {
+            ++prefix;
+        }
+        while (suffix < word.size() && suffix < input.size()
+               && word[word.size() - 1 - suffix] == input[input.size() - 1 - suffix]) {
+            ++suffix;
+        }
+        return prefix + suffix;
+    }
+
+    /*
+     The closeness search reads only the deepest levels, and still finds exactly the best words of a scan of every word :
+     the closer first, then the heavier first, then alphabetically, ties at the last place included.
+     */
+    void check_closeness(const Lexicon& lexicon, const std::string& input) {
+        struct Scored {
+            std::size_t closeness;
+            uint32_t    weight, id;
+        };
+        auto better = [](const Scored& lhs, const Scored& rhs) {
+            if (lhs.closeness != rhs.closeness) {
+                return lhs.closeness > rhs.closeness;
+            }
+            return lhs.weight != rhs.weight ? lhs.weight > rhs.weight : lhs.id < rhs.id;
+        };
+        std::vector<Scored> all;
+        for (uint32_t id = 0; id < lexicon.size(); ++id) {
+            all.push_back({closeness(lexicon.word(id), input), lexicon.weight(id), id});
+        }
+        std::sort(all.begin(), all.end(), better);
+
+        for (int count : {1, 5, 50}) {
+            const std::vector<std::string> found = lexicon.get_suggestions_by_closeness(input, count);
+            CHECK(found.size() == std::min<std::size_t>(count, all.size()));
+            for (std::size_t i = 0; i < found.size(); ++i) {
+                CHECK(found[i] == lexicon.word(all[i].id));
+            }
+        }
+    }
+
+    void test_closeness_same_as_scan() {
+        const std::vector<std::string> words = checks::dict_words();
+        std::vector<uint32_t> weights;
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            weights.push_back(static_cast<uint32_t>(i * 7919 % 13));
+        }
+        const Lexicon unweighted(words), weighted(words, weights);
+
+        std::mt19937 rng(18);
+        std::vector<std::string> qs = {"", "a", "qqqq", "tion", "recieve"};
+        for (int i = 0; i < 100; ++i) {
+            std::string word = words[rng() % words.size()];
+            if (!word.empty()) {
+                word[rng() % word.size()] = static_cast<char>('a' + rng() % 26);
+            }
+            qs.push_back(word);
+        }
+        for (const auto& q : qs) {
+            check_closeness(unweighted, q);
+            check_closeness(weighted, q);
+        }
+        CHECK(unweighted.get_suggestions_by_closeness("word", 0).empty());
+    }
+
+    void test_small_lexicon() {
+        const Lexicon lexicon({"bid", "bad", "cab", "bed", "bad", "Bad", "b-d"}, {1, 2, 3, 4, 5, 6, 7});
+        CHECK(lexicon.size() == 4);
+        CHECK(lexicon.traverse(10) == std::vector<std::string>({"bad", "bed", "bid", "cab"}));
+        // A duplicate is kept once, with its largest weight.
+        CHECK(lexicon.has_weights());
+        CHECK(lexicon.weight(0) == 5);
+        CHECK(lexicon.weight(3) == 3);
+        CHECK(lexicon.get_suggestions_by_prefix("bxx", 10) == std::vector<std::string>({"bad", "bed", "bid"}));
+        CHECK(lexicon.get_suggestions_by_suffix("xxd", 10) == std::vector<std::string>({"bad", "bed", "bid"}));
+        CHECK(lexicon.get_suggestions_by_suffix("xab", 10) == std::vector<std::string>({"cab"}));
+        CHECK(lexicon.get_top_suggestions("b", 2) == std::vector<std::string>({"bad", "bed"}));
+
+        const Lexicon unweighted({"a", "b"}, {0, 0});
+        CHECK(!unweighted.has_weights());
+    }
+
+    // get_top_suggestions against a sort of the run get_suggestions_by_prefix chooses from : the heavier first, then alphabetically.
+    void test_top_suggestions() {
+        const std::vector<std::string> words = checks::dict_words();
+        std::mt19937 rng(15);
+        std::vector<uint32_t> weights;
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            weights.push_back(static_cast<uint32_t>(rng() % 50));
+        }
+        const Lexicon lexicon(words, weights);
+        std::map<std::string, uint32_t, std::less<>> weight_of;
+        for (uint32_t id = 0; id < lexicon.size(); ++id) {
+            weight_of[std::string(lexicon.word(id))] = lexicon.weight(id);
+        }
+
+        for (int round = 0; round < 200; ++round) {
+            const std::string& word = words[rng() % words.size()];
+            const std::string input = word.substr(0, std::min<std::size_t>(word.size(), 1 + rng() % 4));
+            std::vector<std::pair<int64_t, std::string>> keys;
+            for (auto& candidate : lexicon.get_suggestions_by_prefix(input, INT32_MAX)) {
+                keys.emplace_back(-static_cast<int64_t>(weight_of.find(candidate)->second), std::move(candidate));
+            }
+            std::sort(keys.begin(), keys.end());
+            std::vector<std::string> expected;
+            for (auto& [weight, key] : keys) {
+                expected.push_back(std::move(key));
+            }
+            for (const int k : {1, 10, 50}) {
+                const std::vector<std::string> top = lexicon.get_top_suggestions(input, k);
+                CHECK(top.size() == std::min<std::size_t>(k, expected.size()));
+                CHECK(std::equal(top.begin(), top.end(), expected.begin()));
+            }
+        }
+    }
+
+    std::vector<std::string> pieces(const std::vector<std::string_view>& views) {
+        return {views.begin(), views.end()};
+    }
+
+    void test_segment() {
+        const Lexicon small({"the", "them", "me", "mend", "end", "ab", "a", "b"});
+        CHECK(pieces(small.segment("abab")) == std::vector<std::string>({"ab", "ab"}));
+        CHECK(small.segment("themend").size() == 2);
+        CHECK(small.segment("").empty());
+        CHECK(small.segment("thex").empty());
+        // The views point into the text.
+        const std::string text = "abthe";
+        const std::vector<std::string_view> views = small.segment(text);
+        CHECK(views.size() == 2 && views[0].data() == text.data() && views[1].data() == text.data() + 2);
+
+        // With weights, the most likely split wins, even over one with fewer words.
+        const Lexicon likely({"the", "them", "mend", "end", "ab", "a", "b"}, {0, 1000, 0, 1000, 0, 1000000, 1000000});
+        CHECK(pieces(likely.segment("themend")) == std::vector<std::string>({"them", "end"}));
+        CHECK(pieces(likely.segment("ab")) == std::vector<std::string>({"a", "b"}));
+        const Lexicon other_way({"the", "them", "mend", "end"}, {1000, 0, 1000, 0});
+        CHECK(pieces(other_way.segment("themend")) == std::vector<std::string>({"the", "mend"}));
+    }
+
+    // On runs of dictionary words, some with a stray letter, segment finds a split of the fewest words, as a DP over a set does.
+    void test_segment_same_as_brute_force() {
+        const std::vector<std::string> words = checks::dict_words();
+        const Lexicon lexicon(words);
+        const std::set<std::string, std::less<>> dict(words.begin(), words.end());
+        std::mt19937 rng(5);
+        for (int round = 0; round < 500; ++round) {
+            std::string text;
+            for (int i = 1 + static_cast<int>(rng() % 5); i > 0; --i) {
+                text += words[rng() % words.size()];
+            }
+            if (rng() % 4 == 0) {
+                text.insert(text.begin() + static_cast<std::ptrdiff_t>(rng() % (text.size() + 1)), 'q');
+            }
+
+            // fewest[i] is the fewest words text[i, end) splits into, or -1.
+            std::vector<int> fewest(text.size() + 1, -1);
+            fewest[text.size()] = 0;
+            for (std::size_t i = text.size(); i-- > 0;) {
+                for (std::size_t j = i + 1; j <= text.size(); ++j) {
+                    if (fewest[j] != -1 && dict.contains(std::string_view(text).substr(i, j - i))
+                        && (fewest[i] == -1 || fewest[j] + 1 < fewest[i])) {
+                        fewest[i] = fewest[j] + 1;
+                    }
+                }
+            }
+
+            const std::vector<std::string_view> split = lexicon.segment(text);
+            CHECK(static_cast<int>(split.size()) == std::max(fewest[0], 0));
+            std::string joined;
+            for (const auto& piece : split) {
+                CHECK(dict.contains(piece));
+                joined += piece;
+            }
+            CHECK(split.empty() || joined == text);
+        }
+    }
+
+}
+
+int main() {
+    test_same_as_tries();
+    test_closeness_same_as_scan();
+    test_small_lexicon();
+    test_top_suggestions();
+    test_segment();
+    test_segment_same_as_brute_force();
+    return checks::result();
+}
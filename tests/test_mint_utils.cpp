@@ -0,0 +1,79 @@
+#include "check.h"
+
+#include <filesystem>
+
+#include <unistd.h>
+
+namespace {
+
+    bool parses_to(const std::string& line, const std::string& word, uint32_t weight) {
+        const mints::DictEntry entry = mints::parse_dict_line(line);
+        return entry.word == word && entry.weight == weight;
+    }
+
+    void test_parse_dict_line() {
+        CHECK(parses_to("abandon 1520", "abandon", 1520));
+        CHECK(parses_to("Word", "word", 0));
+        CHECK(parses_to("  spaced\t7  ", "spaced", 7));
+        CHECK(parses_to("max 4294967295", "max", UINT32_MAX));
+        CHECK(parses_to("", "", 0));
+
+        // Anything but a word and a number is refused, instead of keeping a part of it.
+        CHECK_THROWS(mints::parse_dict_line("ice cream"), mints::invalid_file_format);
+        CHECK_THROWS(mints::parse_dict_line("word 12x"), mints::invalid_file_format);
+        CHECK_THROWS(mints::parse_dict_line("word -1"), mints::invalid_file_format);
+        CHECK_THROWS(mints::parse_dict_line("word +1"), mints::invalid_file_format);
+        CHECK_THROWS(mints::parse_dict_line("word 4294967296"), mints::invalid_file_format);
+        CHECK_THROWS(mints::parse_dict_line("word 99999999999"), mints::invalid_file_format);
+        CHECK_THROWS(mints::parse_dict_line("word 1 2"), mints::invalid_file_format);
+    }
+
+    // A word list is read line by line; the lines parse_dict_line refuses are skipped.
+    void test_read_dict() {
+        const std::string path = (std::filesystem::temp_directory_path() / "oopfinal_test_words.txt").string();
+        std::ofstream(path) << "abandon 1520\nice cream\nWord\nword 12x\n한국 7\n";
+        const std::vector<mints::DictEntry> entries = mints::read_dict(path);
+        CHECK(entries.size() == 3);
+        CHECK(entries[0].word == "abandon" && entries[0].weight == 1520);
+        CHECK(entries[1].word == "word" && entries[1].weight == 0);
+        CHECK(entries[2].word == "한국" && entries[2].weight == 7);
+        std::filesystem::remove(path);
+        CHECK_THROWS(mints::read_dict(path), mints::unable_to_open_file);
+    }
+
+    // A file is replaced whole : an open stream of the old file keeps reading it, and a failed write leaves it as it was.
+    void test_replace_file() {
+        const std::string path = (std::filesystem::temp_directory_path() / "oopfinal_test_replaced.txt").string();
+        mints::replace_file(path, [](std::ostream& out) { out << "old"; });
+        std::ifstream old_file(path);
+        mints::replace_file(path, [](std::ostream& out) { out << "new"; });
+        std::string text;
+        old_file >> text;
+        CHECK(text == "old");
+        std::ifstream(path) >> text;
+        CHECK(text == "new");
+
+        CHECK_THROWS(mints::replace_file(path, [](std::ostream&) { throw mints::unable_to_open_file("failed"); }),
+                     mints::unable_to_open_file);
+        std::ifstream(path) >> text;
+        CHECK(text == "new");
+        CHECK(!std::filesystem::exists(path + ".tmp." + std::to_string(getpid())));
+        std::filesystem::remove(path);
+
+        CHECK_THROWS(mints::replace_file("/nonexistent/dir/file", [](std::ostream&) {}), mints::unable_to_open_file);
+    }
+
+    void test_split() {
+        CHECK(mints::split("Hello, world!") == (std::vector<std::string>{"hello", "world", ""}));
+        CHECK(mints::make_lowercase("MiXeD 12") == "mixed 12");
+    }
+
+}
+
+int main() {
+    test_parse_dict_line();
+    test_read_dict();
+    test_replace_file();
+    test_split();
+    return checks::result();
+}
@@ -0,0 +1,107 @@
+#include "check.h"
+#include "radix_trie.h"
+#include "trie.h"
+
+#include <random>
+
+namespace {
+
+    // A RadixTrie answers as the Trie of the same words on dict.txt, and writes the same text.
+    template<typename Transform>
+    void test_same_as_trie() {
+        const std::vector<std::string> words = checks::dict_words();
+        const BasicTrie<Ascii26, Transform> trie(words);
+        const BasicRadixTrie<Ascii26, Transform> radix(words);
+
+        std::mt19937 rng(13);
+        std::vector<std::string> queries = {"", "a", "zz", "Apple", "a-b"};
+        for (int i = 0; i < 3000; ++i) {
+            std::string word = words[rng() % words.size()];
+            if (!word.empty() && rng() % 2 == 0) {
+                word[rng() % word.size()] = static_cast<char>('a' + rng() % 26);
+            }
+            queries.push_back(word);
+        }
+        for (const auto& q : queries) {
+            CHECK(radix._contains_(q) == trie._contains_(q));
+            CHECK(radix.get_suggestions(q, 10) == trie.get_suggestions(q, 10));
+        }
+        const int all = static_cast<int>(words.size());
+        CHECK(radix.traverse(all) == trie.traverse(all));
+        CHECK(radix.traverse(INT32_MAX) == trie.traverse(all));
+        CHECK(radix.node_num() < trie.node_num());
+    }
+
+    void test_to_txt_data() {
+        const std::vector<std::string> words = checks::dict_words();
+        CHECK(RadixTrie(words).to_txt_data() == Trie(words).to_txt_data());
+    }
+
+    // The example of radix_trie.h : an edge splits where a word leaves it, and joins back when that word is removed.
+    void test_split_and_join() {
+        RadixTrie radix;
+        radix.push("romane");
+        CHECK(radix.node_num() == 2);
+        CHECK(radix.lookup_depth("romane") == 1);
+
+        radix.push("romanus");
+        radix.push("romulus");
+        // The root, "rom", "an", "e", "us" and "ulus"
+        CHECK(radix.node_num() == 6);
+        CHECK(radix.lookup_depth("romanus") == 3);
+        CHECK(radix.lookup_depth("rome") == 1);
+        CHECK(radix.lookup_depth("xyz") == 0);
+        CHECK(!radix._contains_("rom"));
+        CHECK(!radix._contains_("roman"));
+
+        radix.push("rom");
+        CHECK(radix._contains_("rom"));
+        CHECK(radix.node_num() == 6);
+
+        radix.remove("romanus");
+        radix.remove("rom");
+        // "an" and "e" are joined back into "ane".
+        CHECK(radix.node_num() == 4);
+        CHECK(radix.traverse(10) == std::vector<std::string>({"romane", "romulus"}));
+        CHECK(radix.get_suggestions("romanus", 10) == std::vector<std::string>({"romane"}));
+
+        radix.remove("romulus");
+        CHECK(radix.node_num() == 2);
+        CHECK(radix.lookup_depth("romane") == 1);
+        radix.remove("romane");
+        CHECK(radix.node_num() == 1);
+        CHECK(radix.traverse(10).empty());
+    }
+
+    // Random pushes and removes leave a RadixTrie holding what a Trie holds.
+    void test_random_changes() {
+        const std::vector<std::string> words = checks::dict_words();
+        std::mt19937 rng(14);
+        Trie trie;
+        RadixTrie radix;
+        for (int i = 0; i < 20000; ++i) {
+            const std::string& word = words[rng() % 2000];
+            if (rng() % 3 == 0) {
+                if (trie._contains_(word)) {
+                    trie.remove(word);
+                    radix.remove(word);
+                }
+            } else {
+                trie.push(word);
+                radix.push(word);
+            }
+        }
+        CHECK(radix.traverse(2000) == trie.traverse(2000));
+        CHECK(radix.to_txt_data() == trie.to_txt_data());
+    }
+
+}
+
+int main() {
+    test_same_as_trie<Identity>();
+    test_same_as_trie<Reversed>();
+    test_to_txt_data();
+    test_split_and_join();
+    test_random_changes();
+    return checks::result();
+}
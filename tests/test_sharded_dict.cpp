@@ -0,0 +1,120 @@
+#include "check.h"
+#include "sharded_dict.h"
+
+#include <filesystem>
+#include <random>
+
+namespace {
+
+    const std::string SHARDS = (std::filesystem::temp_directory_path() / "oopfinal_test_dict.shards").string();
+
+    // The sharded dictionary answers as the Trie of all the words.
+    void test_same_as_trie() {
+        const std::vector<std::string> words = checks::dict_words();
+        ShardedDictionary::compile(words, SHARDS);
+        CHECK(ShardedDictionary::is_up_to_date(SHARDS, MINTS_DICT_PATH));
+        const ShardedDictionary dict(SHARDS);
+        const Trie trie(words);
+        CHECK(dict.resident_shard_num() == 0);
+
+        std::vector<std::string> queries = {"", "a", "q", "zz", "xylophone", "Apple", "a-b", "qqqq", "ab"};
+        std::mt19937 rng(12);
+        for (int i = 0; i < 2000; ++i) {
+            std::string word = words[rng() % words.size()];
+            if (!word.empty() && rng() % 2 == 0) {
+                word[rng() % word.size()] = static_cast<char>('a' + rng() % 26);
+            }
+            queries.push_back(word);
+        }
+        std::vector<bool> expected;
+        for (const auto& q : queries) {
+            expected.push_back(trie._contains_(q));
+            CHECK(dict._contains_(q) == trie._contains_(q));
+            CHECK(dict.get_suggestions(q, 10) == trie.get_suggestions(q, 10));
+        }
+        CHECK(dict.contains_many(queries) == expected);
+        CHECK(dict.size() == trie.traverse((int) words.size() + 1).size());
+        CHECK(dict.resident_shard_num() <= ShardedDictionary::DEFAULT_MAX_RESIDENT);
+    }
+
+    // At most max_resident shards are kept; the least recently used one is dropped, and read again when it is needed.
+    void test_lru_eviction() {
+        ShardedDictionary::compile({"abc", "abd", "cab", "cat", "dog", "dot", "egg"}, SHARDS);
+        const ShardedDictionary dict(SHARDS, 2);
+        CHECK(dict.size() == 7);
+
+        CHECK(dict._contains_("abc"));      // loads "ab"
+        CHECK(dict._contains_("cat"));      // loads "ca"
+        CHECK(dict.shard_load_num() == 2);
+        CHECK(dict._contains_("abd"));      // "ab" is resident, and now used after "ca"
+        CHECK(dict.shard_load_num() == 2);
+        CHECK(dict._contains_("dog"));      // loads "do", dropping "ca"
+        CHECK(dict.resident_shard_num() == 2);
+        CHECK(dict.shard_load_num() == 3);
+        CHECK(dict._contains_("abc"));      // "ab" stayed
+        CHECK(dict.shard_load_num() == 3);
+        CHECK(dict._contains_("cab"));      // "ca" is read again, dropping "do"
+        CHECK(dict.shard_load_num() == 4);
+        CHECK(dict._contains_("dot"));
+        CHECK(dict.shard_load_num() == 5);
+        CHECK(dict.resident_shard_num() == 2);
+
+        // A word of no shard, or of an empty one, loads nothing.
+        CHECK(!dict._contains_("zebra"));
+        CHECK(!dict._contains_("1st"));
+        CHECK(dict.shard_load_num() == 5);
+
+        // A batch reads each of its shards once, even with a cap below the shards it needs.
+        const ShardedDictionary batch(SHARDS, 1);
+        const std::vector<std::string> words = {"cat", "abc", "dog", "cab", "abd", "dot", "egg", "eggs"};
+        CHECK(batch.contains_many(words) == std::vector<bool>({true, true, true, true, true, true, true, false}));
+        CHECK(batch.shard_load_num() == 4);
+        CHECK(batch.resident_shard_num() == 1);
+    }
+
+    // Compiling again replaces the file : a dictionary opened before keeps reading its shards from the old words.
+    void test_recompile_keeps_open_dictionaries() {
+        ShardedDictionary::compile({"abc", "abd", "cab", "cat", "dog"}, SHARDS);
+        const ShardedDictionary old_dict(SHARDS);
+        CHECK(old_dict._contains_("abc"));      // loads "ab" from the old file
+        ShardedDictionary::compile({"aardvark", "abacus", "abbey", "cabbage", "cabin", "doe", "dormouse"}, SHARDS);
+        const ShardedDictionary new_dict(SHARDS);
+
+        // The shards read after the new file was written still come from the old one.
+        CHECK(old_dict._contains_("cat"));
+        CHECK(old_dict._contains_("dog"));
+        CHECK(!old_dict._contains_("cabin"));
+        CHECK(old_dict.get_suggestions("cax", 10) == std::vector<std::string>({"cab", "cat"}));
+        CHECK(old_dict.size() == 5);
+        CHECK(new_dict._contains_("cabin"));
+        CHECK(!new_dict._contains_("cat"));
+        CHECK(new_dict.size() == 7);
+    }
+
+    void test_broken_files() {
+        CHECK_THROWS(ShardedDictionary("/nonexistent/dict.shards"), mints::unable_to_open_file);
+        ShardedDictionary::compile({"abc", "cab"}, SHARDS);
+        std::ifstream ifile(SHARDS, std::ios::binary);
+        const std::string bytes{std::istreambuf_iterator<char>(ifile), std::istreambuf_iterator<char>()};
+        ifile.close();
+
+        std::ofstream(SHARDS, std::ios::binary | std::ios::trunc) << bytes.substr(0, 20);
+        CHECK_THROWS(ShardedDictionary(SHARDS), mints::invalid_file_format);
+        std::ofstream(SHARDS, std::ios::binary | std::ios::trunc) << "X" + bytes.substr(1);
+        CHECK_THROWS(ShardedDictionary(SHARDS), mints::invalid_file_format);
+        std::ofstream(SHARDS, std::ios::binary | std::ios::trunc) << bytes.substr(0, bytes.size() - 2);
+        CHECK_THROWS(ShardedDictionary(SHARDS), mints::invalid_file_format);
+
+        std::filesystem::remove(SHARDS);
+        CHECK(!ShardedDictionary::is_up_to_date(SHARDS, MINTS_DICT_PATH));
+    }
+
+}
+
+int main() {
+    test_same_as_trie();
+    test_lru_eviction();
+    test_recompile_keeps_open_dictionaries();
+    test_broken_files();
+    return checks::result();
+}
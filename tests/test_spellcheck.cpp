@@ -0,0 +1,141 @@
+#include "check.h"
+#include "holders.h"
+
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+    /*
+     Run a spell-check on a StringHolder holding 'text', answering its questions with 'answers' (the numbers of the
+     chosen suggestions, 0 to keep a word), and return the text of the holder afterwards.
+     */
+    template<typename Spellcheck>
+    std::string spellchecked(const std::string& text, const std::string& answers, Spellcheck&& spellcheck) {
+        StringHolder holder({"title", text});
+        std::istringstream in(answers);
+        std::ostringstream out;
+        std::streambuf* const cin_buf = std::cin.rdbuf(in.rdbuf());
+        std::streambuf* const cout_buf = std::cout.rdbuf(out.rdbuf());
+        spellcheck(holder);
+
+        std::ostringstream printed;
+        std::cout.rdbuf(printed.rdbuf());
+        holder.print();
+        std::cout.rdbuf(cout_buf);
+        std::cin.rdbuf(cin_buf);
+
+        // print() shows the text, a newline the holder keeps after it, and its own newline.
+        std::string ret = printed.str();
+        return ret.substr(0, ret.size() - 2);
+    }
+
+    void test_frozen_trie() {
+        const Trie trie(checks::dict_words());
+        const FrozenTrie frozen = trie.freeze();
+
+        // 0 keeps the misspelled word.
+        CHECK(spellchecked("The quick brwn fox", "0\n", [&frozen](StringHolder& holder) {
+            holder.spellcheck(frozen, 10);
+        }) == "The quick brwn fox");
+
+        // By closeness, the first suggestion is the first word sharing the longest prefix.
+        const std::string by_prefix = trie.get_suggestions("brwn", 10)[0];
+        CHECK(spellchecked("The quick brwn fox", "1\n", [&frozen](StringHolder& holder) {
+            holder.spellcheck(frozen, 10);
+        }) == "The quick " + by_prefix + " fox");
+
+        // By edit distance, one of the closest words; "brown" is one letter away.
+        const std::vector<std::string> within = trie.get_suggestions_within("brwn", StringHolder::MAX_EDIT_DISTANCE, 10);
+        const auto brown = std::find(within.begin(), within.end(), "brown");
+        CHECK(brown != within.end());
+        const std::string answer = std::to_string(brown - within.begin() + 1) + "\n";
+        CHECK(spellchecked("The quick brwn fox", answer, [&frozen](StringHolder& holder) {
+            holder.spellcheck(frozen, 10, StringHolder::BY_EDIT_DISTANCE);
+        }) == "The quick brown fox");
+    }
+
+    void test_lexicon() {
+        const Lexicon dict(checks::dict_words());
+
+        // By closeness, the first of the words sharing the longest prefix plus suffix
+        const std::vector<std::string> closest = dict.get_suggestions_by_closeness("brwn", 10);
+        CHECK(spellchecked("The quick brwn fox", "1\n", [&dict](StringHolder& holder) {
+            holder.spellcheck(dict, 10);
+        }) == "The quick " + closest[0] + " fox");
+
+        // A word which lost its spaces is offered split first.
+        CHECK(spellchecked("thequick fox", "1\n", [&dict](StringHolder& holder) {
+            holder.spellcheck(dict, 10);
+        }) == "the quick fox");
+        CHECK(spellchecked("The quick fox", "", [&dict](StringHolder& holder) {
+            holder.spellcheck(dict, 10);
+        }) == "The quick fox");
+    }
+
+    // A Dawg suggests as the Trie of the same words.
+    void test_dawg() {
+        const std::vector<std::string> words = checks::dict_words();
+        const Trie trie(words);
+        const Dawg dawg(words);
+        CHECK(spellchecked("The quick brwn fox", "1\n", [&dawg](StringHolder& holder) {
+            holder.spellcheck(dawg, 10);
+        }) == "The quick " + trie.get_suggestions("brwn", 10)[0] + " fox");
+        CHECK(spellchecked("The quick brwn fox", "1\n", [&dawg](StringHolder& holder) {
+            holder.spellcheck(dawg, 10, StringHolder::BY_EDIT_DISTANCE);
+        }) == "The quick " + trie.get_suggestions_within("brwn", StringHolder::MAX_EDIT_DISTANCE, 10)[0] + " fox");
+    }
+
+    // fix_spacing splits the misspelled runs of words only, keeps their capitals, and counts them.
+    void test_fix_spacing() {
+        const Lexicon dict(checks::dict_words());
+        int split_num = -1;
+        CHECK(spellchecked("Theprogram isclosed, but the door is open. Qqqzx stays.", "", [&](StringHolder& holder) {
+            split_num = holder.fix_spacing(dict);
+        }) == "The program is closed, but the door is open. Qqqzx stays.");
+        CHECK(split_num == 2);
+    }
+
+    // The spell-check with a ShardedDictionary suggests as the Trie of all the words, and reads only the shards it needs.
+    void test_sharded_dictionary() {
+        const std::vector<std::string> words = checks::dict_words();
+        const std::string path = (std::filesystem::temp_directory_path() / "oopfinal_test_spellcheck.shards").string();
+        ShardedDictionary::compile(words, path);
+        const ShardedDictionary dict(path);
+        const Trie trie(words);
+        CHECK(spellchecked("The quick brwn fox", "1\n", [&dict](StringHolder& holder) {
+            holder.spellcheck(dict, 10);
+        }) == "The quick " + trie.get_suggestions("brwn", 10)[0] + " fox");
+        // "th", "qu", "br" and "fo"
+        CHECK(dict.resident_shard_num() == 4);
+        std::filesystem::remove(path);
+    }
+
+    // The Korean spell-check checks the words holding Hangul only, and keeps the bytes around them.
+    void test_hangul() {
+        const HangulTrie dict(std::vector<std::string>{"한국", "한국어", "한글", "학교"});
+        // 한굴 is one jamo away from both 한글 and 한국.
+        const std::vector<std::string> within = dict.get_suggestions_within("한굴", StringHolder::MAX_EDIT_DISTANCE, 10);
+        const auto hangeul = std::find(within.begin(), within.end(), "한글");
+        CHECK(hangeul != within.end());
+        const std::string answer = std::to_string(hangeul - within.begin() + 1) + "\n";
+        CHECK(spellchecked("한굴 and 학교, speling!", answer, [&dict](StringHolder& holder) {
+            holder.spellcheck(dict, 10, StringHolder::BY_EDIT_DISTANCE);
+        }) == "한글 and 학교, speling!");
+        CHECK(spellchecked("학교 한국어.", "", [&dict](StringHolder& holder) {
+            holder.spellcheck(dict, 10);
+        }) == "학교 한국어.");
+    }
+
+}
+
+int main() {
+    test_frozen_trie();
+    test_lexicon();
+    test_dawg();
+    test_fix_spacing();
+    test_sharded_dictionary();
+    test_hangul();
+    return checks::result();
+}
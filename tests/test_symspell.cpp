@@ -0,0 +1,48 @@
+#include "check.h"
+#include "symspell.h"
+#include "trie.h"
+
+#include <random>
+
+namespace {
+
+    // The index suggests the same words as the walk of the dictionary Trie within 2 edits, in the same order.
+    void test_same_as_trie_walk() {
+        const std::vector<std::string> words = checks::dict_words();
+        const SymSpellIndex index(words);
+        const Trie trie(words);
+
+        std::mt19937 rng(7);
+        for (int i = 0; i < 300; ++i) {
+            std::string word = words[rng() % words.size()];
+            for (int edits = static_cast<int>(rng() % 3); edits > 0 && !word.empty(); --edits) {
+                const std::size_t pos = rng() % word.size();
+                switch (rng() % 3) {
+                    case 0:  word[pos] = static_cast<char>('a' + rng() % 26); break;
+                    case 1:  word.insert(word.begin() + static_cast<long>(pos), static_cast<char>('a' + rng() % 26)); break;
+                    default: word.erase(pos, 1); break;
+                }
+            }
+            CHECK(index._contains_(word) == trie._contains_(word));
+            CHECK(index.get_suggestions(word, 1000) == trie.get_suggestions_within(word, 2, 1000));
+        }
+    }
+
+    void test_small_index() {
+        const SymSpellIndex index({"the", "then", "tea", "other", "Capital", "a-b", ""});
+        CHECK(index._contains_("the"));
+        CHECK(!index._contains_("th"));
+        CHECK(!index._contains_("a-b"));
+        CHECK(index.size() == 4);
+        CHECK(index.get_suggestions("teh", 10) == std::vector<std::string>({"tea", "the", "then"}));
+        CHECK(index.get_suggestions("teh", 1) == std::vector<std::string>({"tea"}));
+        CHECK(index.get_suggestions("xyzzy", 10).empty());
+    }
+
+}
+
+int main() {
+    test_same_as_trie_walk();
+    test_small_index();
+    return checks::result();
+}
@@ -0,0 +1,479 @@
+#include "check.h"
+#include "trie.h"
+#include "lexicon.h"
+
+#include <map>
+#include <random>
+#include <set>
+
+namespace {
+
+    // Nodes come out of chunks of the arena, and a released subtree is handed out again before a new chunk is made.
+    void test_arena_recycles_nodes() {
+        NodeArena arena;
+        Node root(35, 0);
+        for (int i = 0; i < 26; ++i) {
+            root.put(i, static_cast<char>('a' + i), arena);
+        }
+        Node* chain = root.get_next(0);
+        for (int level = 2; level < 3000; ++level) {
+            chain->put(1, 'b', arena);
+            chain = chain->get_next(1);
+        }
+        CHECK(arena.node_num() == 26 + 2998);
+        const std::size_t bytes = arena.memory_usage();
+
+        // The 'a' subtree holds the chain.
+        root.remove(0, arena);
+        CHECK(arena.node_num() == 25);
+        CHECK(root.get_next(0) == nullptr);
+
+        root.put(0, 'a', arena);
+        chain = root.get_next(0);
+        for (int level = 2; level < 3000; ++level) {
+            chain->put(1, 'b', arena);
+            chain = chain->get_next(1);
+        }
+        CHECK(arena.node_num() == 26 + 2998);
+        CHECK(arena.memory_usage() == bytes);
+    }
+
+    void test_remove_gives_nodes_back() {
+        const std::vector<std::string> words = checks::dict_words();
+        Trie trie(words);
+        const std::size_t nodes = trie.node_num(), bytes = trie.memory_usage();
+
+        for (const auto& word : words) {
+            trie.remove(word);
+        }
+        CHECK(trie.node_num() == 1);
+        CHECK(trie.traverse(10).empty());
+
+        for (const auto& word : words) {
+            trie.push(word);
+        }
+        CHECK(trie.node_num() == nodes);
+        // The nodes and blocks of the first build are reused, so no new chunk is needed.
+        CHECK(trie.memory_usage() <= bytes);
+        for (const auto& word : words) {
+            CHECK(trie._contains_(word));
+        }
+    }
+
+    // Tries built and dropped one after another hold exactly the words of the list.
+    void test_many_tries() {
+        const std::vector<std::string> words = checks::dict_words();
+        std::set<std::string> expected;
+        for (const auto& word : words) {
+            if (!word.empty() && std::all_of(word.begin(), word.end(), [](char c) { return 'a' <= c && c <= 'z'; })) {
+                expected.insert(word);
+            }
+        }
+        for (int round = 0; round < 3; ++round) {
+            Trie trie(words);
+            ReversedTrie reversed(words);
+            const std::vector<std::string> all = trie.traverse(static_cast<int>(words.size()));
+            CHECK(std::set<std::string>(all.begin(), all.end()) == expected);
+            CHECK(reversed.traverse(static_cast<int>(words.size())).size() == expected.size());
+        }
+    }
+
+    // A node keeps only the children it has, in alphabetical order, behind a mask of their letters.
+    void test_packed_children() {
+        NodeArena arena;
+        Node root(35, 0);
+        for (int idx : {23, 1, 25, 4, 0}) {
+            root.put(idx, static_cast<char>('a' + idx), arena);
+        }
+        const Node::Children children = root.get_children();
+        CHECK(children.size() == 5);
+        CHECK(children.mask() == ((1u << 0) | (1u << 1) | (1u << 4) | (1u << 23) | (1u << 25)));
+        std::string letters;
+        for (int i = 0; i < children.size(); ++i) {
+            letters += children[i]->get_char();
+        }
+        CHECK(letters == "abexz");
+        for (int idx = 0; idx < 26; ++idx) {
+            const bool has = letters.find(static_cast<char>('a' + idx)) != std::string::npos;
+            CHECK((root.get_next(idx) != nullptr) == has);
+            CHECK(children.find(idx) == root.get_next(idx));
+        }
+        CHECK(root.get_next(-1) == nullptr);
+        CHECK(root.get_next(Node::MAX_CHILDREN) == nullptr);
+        CHECK_THROWS(root.put(4, 'e', arena), mints::double_alloc);
+
+        root.remove(4, arena);
+        CHECK(root.get_children().size() == 4);
+        CHECK(root.get_next(4) == nullptr);
+        CHECK(root.get_next(23)->get_char() == 'x');
+        CHECK(root.get_next(25)->get_char() == 'z');
+    }
+
+    // The words come out in alphabetical order, whatever order the children were put in.
+    void test_traverse_order() {
+        Trie trie;
+        for (const char* word : {"zoo", "apple", "mango", "app", "zebra", "b"}) {
+            trie.push(word);
+        }
+        CHECK(trie.traverse(10) == std::vector<std::string>({"app", "apple", "b", "mango", "zebra", "zoo"}));
+        CHECK(trie.traverse(2) == std::vector<std::string>({"app", "apple"}));
+        trie.remove("mango");
+        CHECK(trie.traverse(10) == std::vector<std::string>({"app", "apple", "b", "zebra", "zoo"}));
+        CHECK(!trie._contains_("mango"));
+        CHECK(!trie._contains_("ap"));
+        CHECK(!trie._contains_("Apple"));
+    }
+
+    // contains_many answers as _contains_ for any batch : longer and shorter than the lookups kept in flight, with misses,
+    // words out of the alphabet and words just removed.
+    template<typename Transform>
+    void test_contains_many() {
+        const std::vector<std::string> words = checks::dict_words();
+        BasicTrie<Ascii26, Transform> trie(words);
+        for (std::size_t i = 0; i < words.size(); i += 5) {
+            trie.remove(words[i]);
+        }
+
+        std::mt19937 rng(9);
+        std::vector<std::string> queries = {"", "a", "Apple", "a-b"};
+        for (int i = 0; i < 5000; ++i) {
+            std::string word = words[rng() % words.size()];
+            if (!word.empty() && rng() % 3 == 0) {
+                word[rng() % word.size()] = static_cast<char>('a' + rng() % 26);
+            }
+            queries.push_back(word);
+        }
+
+        for (std::size_t batch : {std::size_t{0}, std::size_t{1}, std::size_t{15}, std::size_t{17}, queries.size()}) {
+            const std::span<const std::string> inputs(queries.data(), batch);
+            const std::vector<bool> found = trie.contains_many(inputs);
+            CHECK(found.size() == batch);
+            for (std::size_t i = 0; i < found.size(); ++i) {
+                CHECK(found[i] == trie._contains_(inputs[i]));
+            }
+        }
+    }
+
+    void test_policies() {
+        CHECK(Ascii26::index('a') == 0);
+        CHECK(Ascii26::index('z') == 25);
+        CHECK(Ascii26::index('A') == -1);
+        CHECK(Ascii26::index('-') == -1);
+        CHECK(Identity::at("word", 1) == 'o');
+        CHECK(Reversed::at("word", 0) == 'd');
+        CHECK(Reversed{}("word") == "drow");
+        std::string stored = "drow";
+        Reversed::restore(stored);
+        CHECK(stored == "word");
+    }
+
+    // A ReversedTrie takes the words as they are, and stores them from the last letter so that suffixes share paths.
+    // traverse gives the words as they are stored; suggestions are restored.
+    void test_reversed_trie() {
+        ReversedTrie trie;
+        for (const char* word : {"walking", "talking", "king", "walked", "tree"}) {
+            trie.push(word);
+        }
+        CHECK(trie._contains_("walking"));
+        CHECK(!trie._contains_("gniklaw"));
+        // The root, "gnik", "la", 'w' and 't' after them, "deklaw" and "eert"
+        CHECK(trie.node_num() == 1 + 4 + 2 + 2 + 6 + 4);
+        CHECK(trie.traverse(10) == std::vector<std::string>({"deklaw", "eert", "gnik", "gniklat", "gniklaw"}));
+        CHECK(trie.get_suggestions("stalking", 10) == std::vector<std::string>({"talking"}));
+
+        // Removing goes through the transform too, and gives back the nodes of the suffix no other word has.
+        trie.remove("walking");
+        CHECK(!trie._contains_("walking"));
+        CHECK(trie._contains_("talking"));
+        CHECK(trie.node_num() == 1 + 4 + 2 + 1 + 6 + 4);
+        trie.remove("walked");
+        CHECK(trie.traverse(10) == std::vector<std::string>({"eert", "gnik", "gniklat"}));
+    }
+
+    // The bulk build makes the Trie that pushing the words one by one makes, whatever the order of the words.
+    template<typename Transform>
+    void test_bulk_build_same_as_push() {
+        std::vector<std::string> words = checks::dict_words();
+        words.insert(words.end(), {"", "a-b", "Apple", "zzz", "zzz", "apple"});
+
+        std::vector<std::string> sorted = words, reversed = words;
+        std::sort(sorted.begin(), sorted.end());
+        std::reverse(reversed.begin(), reversed.end());
+        for (const auto* list : {&words, &sorted, &reversed}) {
+            BasicTrie<Ascii26, Transform> pushed;
+            for (const auto& word : *list) {
+                pushed.push(word);
+            }
+            BasicTrie<Ascii26, Transform> built(*list);
+            CHECK(built.node_num() == pushed.node_num());
+            CHECK(built.to_txt_data() == pushed.to_txt_data());
+            CHECK(built.root_state()->get_offspring_num() == pushed.root_state()->get_offspring_num());
+
+            // Both go on the same way afterwards.
+            for (std::size_t i = 0; i < list->size(); i += 3) {
+                built.remove((*list)[i]);
+                pushed.remove((*list)[i]);
+            }
+            built.push("zzzz");
+            pushed.push("zzzz");
+            CHECK(built.node_num() == pushed.node_num());
+            CHECK(built.to_txt_data() == pushed.to_txt_data());
+        }
+    }
+
+    // The parallel build makes the Trie the sequential build makes, with unique word ids, and goes on the same way.
+    template<typename Transform>
+    void test_parallel_build() {
+        const std::vector<std::string> base = checks::dict_words();
+        std::mt19937 rng(15);
+        std::vector<std::string> words;
+        // More than BasicTrie::PARALLEL_MIN_WORDS, so that the threads are used
+        for (std::size_t i = 0; i < (1 << 16) + (1 << 14); ++i) {
+            words.push_back(base[rng() % base.size()] + base[rng() % base.size()]);
+        }
+        words.insert(words.end(), {"", "a-b", "Apple"});
+
+        BasicTrie<Ascii26, Transform> sequential(words);
+        const std::string text = sequential.to_txt_data();
+        for (unsigned thread_num : {2u, 5u}) {
+            BasicTrie<Ascii26, Transform> parallel(words, thread_num);
+            CHECK(parallel.node_num() == sequential.node_num());
+            CHECK(parallel.to_txt_data() == text);
+
+            std::set<uint32_t> ids;
+            for (const auto& word : words) {
+                const Node* node = parallel.root_state();
+                for (std::size_t i = 0; node != nullptr && i < word.size(); ++i) {
+                    const int idx = Ascii26::index(Transform::at(word, i));
+                    node = idx == -1 ? nullptr : node->get_next(idx);
+                }
+                if (node != nullptr && node->is_end()) {
+                    ids.insert(node->get_word());
+                }
+            }
+            CHECK(ids.size() == sequential.traverse(static_cast<int>(words.size())).size());
+
+            if (thread_num == 5) {
+                for (std::size_t i = 0; i < words.size(); i += 3) {
+                    sequential.remove(words[i]);
+                    parallel.remove(words[i]);
+                }
+                CHECK(parallel.node_num() == sequential.node_num());
+                CHECK(parallel.to_txt_data() == sequential.to_txt_data());
+            }
+        }
+    }
+
+    // A word longer than a node level can count is skipped, by push and by the bulk build alike.
+    void test_too_long_words() {
+        const std::string longest(Node::MAX_WORD_LENGTH, 'a');
+        const std::string too_long(Node::MAX_WORD_LENGTH + 1, 'b');
+
+        Trie pushed;
+        pushed.push("apple");
+        pushed.push(too_long);
+        pushed.push(longest);
+        CHECK(!pushed._contains_(too_long));
+        CHECK(pushed._contains_(longest));
+        CHECK(pushed._contains_("apple"));
+        CHECK(pushed.traverse(10) == std::vector<std::string>({longest, "apple"}));
+        CHECK(pushed.node_num() == 1 + Node::MAX_WORD_LENGTH + 4);
+
+        Trie built(std::vector<std::string>{"apple", longest, too_long, "banana"});
+        CHECK(!built._contains_(too_long));
+        CHECK(built.traverse(10) == std::vector<std::string>({longest, "apple", "banana"}));
+    }
+
+    /*
+     get_top_suggestions against a sort of every word get_suggestions chooses from : the heavier first, then alphabetically
+     in the stored order. Weights below 50 give plenty of ties. Checked again after reweights and removes.
+     */
+    template<typename Transform>
+    void test_top_suggestions() {
+        const std::vector<std::string> words = checks::dict_words();
+        BasicTrie<Ascii26, Transform> trie;
+        std::map<std::string, uint32_t> weight_of;
+        std::mt19937 rng(13);
+        for (const auto& word : words) {
+            weight_of[word] = static_cast<uint32_t>(rng() % 50);
+            trie.push(word, weight_of[word]);
+        }
+
+        // The stored order is that of the words read through the Transform; restore turns a word either way.
+        auto stored = [](std::string word) {
+            Transform::restore(word);
+            return word;
+        };
+        auto check_prefixes = [&]() {
+            std::mt19937 pick(14);
+            for (int round = 0; round < 60; ++round) {
+                const std::string& word = words[pick() % words.size()];
+                const std::string input = stored(stored(word).substr(0, 1 + pick() % 4));
+                // Sorted by (-weight, stored word), then the words taken back out
+                std::vector<std::pair<int64_t, std::string>> keys;
+                for (const auto& candidate : trie.get_suggestions(input, INT32_MAX)) {
+                    keys.emplace_back(-static_cast<int64_t>(weight_of[candidate]), stored(candidate));
+                }
+                std::sort(keys.begin(), keys.end());
+                std::vector<std::string> expected;
+                for (auto& [weight, key] : keys) {
+                    expected.push_back(stored(std::move(key)));
+                }
+                for (const int k : {1, 10, 50}) {
+                    const std::vector<std::string> top = trie.get_top_suggestions(input, k);
+                    CHECK(top.size() == std::min<std::size_t>(k, expected.size()));
+                    CHECK(std::equal(top.begin(), top.end(), expected.begin()));
+                }
+            }
+        };
+        check_prefixes();
+
+        for (int i = 0; i < 3000; ++i) {
+            const std::string& word = words[rng() % words.size()];
+            if (rng() % 3 == 0) {
+                trie.remove(word);
+                weight_of.erase(word);
+            } else {
+                weight_of[word] = static_cast<uint32_t>(rng() % 50);
+                trie.push(word, weight_of[word]);
+            }
+        }
+        check_prefixes();
+    }
+
+    // A cursor follows the typed letters, steps back on a backspace, and counts the letters typed off the Trie.
+    void test_cursor() {
+        Trie trie(std::vector<std::string>{"car", "card", "care", "cat", "dog"});
+        Trie::Cursor cursor = trie.cursor();
+        for (char c : std::string("ca")) {
+            cursor.advance(c);
+        }
+        CHECK(cursor.is_prefix());
+        CHECK(!cursor.is_word());
+        CHECK(cursor.completions(10) == std::vector<std::string>({"car", "card", "care", "cat"}));
+        CHECK(cursor.completions(2) == std::vector<std::string>({"car", "card"}));
+
+        cursor.advance('r');
+        CHECK(cursor.is_word());
+        cursor.advance('x');
+        cursor.advance('y');
+        CHECK(!cursor.is_prefix());
+        CHECK(cursor.completions(10).empty());
+        cursor.backspace();
+        cursor.backspace();
+        CHECK(cursor.get_typed() == "car");
+        CHECK(cursor.completions(10) == std::vector<std::string>({"car", "card", "care"}));
+
+        cursor.reset();
+        cursor.advance('d');
+        CHECK(cursor.completions(10) == std::vector<std::string>({"dog"}));
+    }
+
+    /*
+     Random typing sessions with backspaces : after every keystroke, the cursor answers as the lookups from the root do.
+     The letters are typed in the stored order, so the typed letters of a ReversedTrie read the word from its end.
+     */
+    template<typename Transform>
+    void test_cursor_sessions() {
+        const std::vector<std::string> words = checks::dict_words();
+        const BasicTrie<Ascii26, Transform> trie(words);
+        std::set<std::string, std::less<>> stored;
+        for (const auto& word : words) {
+            stored.insert(Transform()(word));
+        }
+
+        std::mt19937 rng(20);
+        for (int session = 0; session < 500; ++session) {
+            const std::string target = Transform()(words[rng() % words.size()]);
+            typename BasicTrie<Ascii26, Transform>::Cursor cursor = trie.cursor();
+            std::string typed;
+            for (int key = 0; key < 2 * static_cast<int>(target.size()) + 4; ++key) {
+                const unsigned roll = rng() % 10;
+                if (roll < 2) {
+                    cursor.backspace();
+                    if (!typed.empty()) {
+                        typed.pop_back();
+                    }
+                } else {
+                    // Mostly the next letter of the word, sometimes a typo
+                    const char c = roll < 8 && typed.size() < target.size() && target.starts_with(typed)
+                                   ? target[typed.size()] : static_cast<char>('a' + rng() % 26);
+                    cursor.advance(c);
+                    typed += c;
+                }
+
+                std::string word = typed;
+                Transform::restore(word);
+                const auto next = stored.lower_bound(typed);
+                const bool is_prefix = next != stored.end() && next->starts_with(typed);
+                CHECK(cursor.get_typed() == typed);
+                CHECK(cursor.is_word() == trie._contains_(word));
+                CHECK(cursor.is_prefix() == is_prefix);
+                if (is_prefix) {
+                    CHECK(cursor.completions(5) == trie.get_suggestions(word, 5));
+                } else {
+                    CHECK(cursor.completions(5).empty());
+                }
+            }
+        }
+    }
+
+    // A Trie bulk built from a Lexicon, with the weights pushed afterwards as Listener does,
+    // completes heaviest first, like the Lexicon suggests the heaviest words of the same prefix.
+    void test_weighted_completions() {
+        const std::vector<std::string> words = checks::dict_words();
+        std::vector<uint32_t> weights;
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            weights.push_back(static_cast<uint32_t>((i * 7919) % 100003 + 1));
+        }
+        const Lexicon dict(words, weights);
+        Trie trie(dict.traverse((int) dict.size()), 2);
+        std::map<std::string, uint32_t, std::less<>> weight_of;
+        for (uint32_t id = 0; id < dict.size(); ++id) {
+            trie.push(std::string(dict.word(id)), dict.weight(id));
+            weight_of[std::string(dict.word(id))] = dict.weight(id);
+        }
+
+        for (const char* prefix : {"a", "ca", "pro", "th", "zz"}) {
+            Trie::Cursor cursor = trie.cursor();
+            for (const char* c = prefix; *c != '\0'; ++c) {
+                cursor.advance(*c);
+            }
+            if (!cursor.is_prefix()) {
+                CHECK(cursor.completions(10).empty());
+                continue;
+            }
+            const std::vector<std::string> completions = cursor.completions(10);
+            CHECK(completions == dict.get_top_suggestions(prefix, 10));
+            CHECK(completions == trie.get_top_suggestions(prefix, 10));
+            for (std::size_t i = 1; i < completions.size(); ++i) {
+                CHECK(weight_of[completions[i - 1]] > weight_of[completions[i]]);
+            }
+        }
+    }
+
+}
+
+int main() {
+    test_arena_recycles_nodes();
+    test_packed_children();
+    test_traverse_order();
+    test_remove_gives_nodes_back();
+    test_many_tries();
+    test_too_long_words();
+    test_top_suggestions<Identity>();
+    test_top_suggestions<Reversed>();
+    test_cursor();
+    test_cursor_sessions<Identity>();
+    test_cursor_sessions<Reversed>();
+    test_weighted_completions();
+    test_policies();
+    test_reversed_trie();
+    test_bulk_build_same_as_push<Identity>();
+    test_bulk_build_same_as_push<Reversed>();
+    test_parallel_build<Identity>();
+    test_parallel_build<Reversed>();
+    test_contains_many<Identity>();
+    test_contains_many<Reversed>();
+    return checks::result();
+}
@@ -0,0 +1,70 @@
+#include "check.h"
+#include "trie.h"
+#include "wildcard.h"
+
+namespace {
+
+    // The words of 'words' matching 'pattern', by a scan of every word
+    std::vector<std::string> scan(const std::vector<std::string>& words, const std::string& pattern) {
+        const WildcardPattern compiled(pattern);
+        std::vector<std::string> ret;
+        for (const auto& word : words) {
+            if (compiled.matches(word)) {
+                ret.push_back(word);
+            }
+        }
+        std::sort(ret.begin(), ret.end());
+        return ret;
+    }
+
+    std::vector<std::string> sorted(std::vector<std::string> words) {
+        std::sort(words.begin(), words.end());
+        return words;
+    }
+
+    void test_pattern() {
+        CHECK(WildcardPattern("c?t").matches("cat"));
+        CHECK(!WildcardPattern("c?t").matches("ct"));
+        CHECK(WildcardPattern("c*t").matches("ct"));
+        CHECK(WildcardPattern("c**t").matches("cabinet"));
+        CHECK(WildcardPattern("[bc]at").matches("bat"));
+        CHECK(!WildcardPattern("[bc]at").matches("rat"));
+        CHECK(WildcardPattern("[a-c]at").matches("cat"));
+        CHECK(!WildcardPattern("[^bc]at").matches("cat"));
+        CHECK(WildcardPattern("[!bc]at").matches("rat"));
+        CHECK(WildcardPattern("*").matches(""));
+        CHECK(!WildcardPattern("?").matches(""));
+        CHECK(WildcardPattern("cat").reversed().matches("tac"));
+
+        CHECK_THROWS(WildcardPattern("[abc"), mints::invalid_pattern);
+        CHECK_THROWS(WildcardPattern(std::string(64, '?')), mints::invalid_pattern);
+        const Trie trie(std::vector<std::string>{"cat"});
+        CHECK_THROWS(trie.match("c[at"), mints::invalid_pattern);
+    }
+
+    // The Trie and the ReversedTrie find the same words as a scan, the Trie alphabetically, and stop where they are told.
+    void test_against_scan() {
+        const std::vector<std::string> words = checks::dict_words();
+        const Trie trie(words);
+        const ReversedTrie reversed(words);
+
+        for (const char* pattern : {"cro?sw*d", "stan*", "[bc]?t", "*tion", "*q*", "?", "a*a", "[^aeiou][aeiou]?",
+                                    "*[xz]", "zzz*", "[a-c]*ing", ""}) {
+            const std::vector<std::string> expected = scan(words, pattern);
+            const std::vector<std::string> found = trie.get_matches(pattern, (int) words.size());
+            CHECK(found == expected);
+            CHECK(sorted(reversed.get_matches(pattern, (int) words.size())) == expected);
+
+            const std::vector<std::string> capped = trie.get_matches(pattern, 5);
+            CHECK(capped.size() == std::min<std::size_t>(5, expected.size()));
+            CHECK(std::equal(capped.begin(), capped.end(), expected.begin()));
+        }
+    }
+
+}
+
+int main() {
+    test_pattern();
+    test_against_scan();
+    return checks::result();
+}
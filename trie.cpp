@@ -1,67 +1,130 @@
 #include "trie.h"
+#include "frozen_trie.h"
+#include "edit_distance.h"
+#include "hangul.h"
 
-Node::Node(char _c, int _level) : ch(_c), level(_level), to_data(nullptr), offspring_num(0) {
-    for (int i = 0; i < 26; ++i) {
-        next[i] = nullptr;
+#include <queue>
+#include <thread>
+
+Node::Node(char _c, int _level)
+        : children(nullptr), word(NO_WORD), weight(0), max_weight(0), level(_level), offspring_num(0), ch(_c) {}
+
+void Node::put(int idx, char c, NodeArena& arena) {
+    const ChildMask bit = ChildMask{1} << idx;
+    // Only the writer changes 'children', so a relaxed load sees its own last store.
+    ChildSlot* old_block = children.load(std::memory_order_relaxed);
+    const Children old(old_block);
+    if (old.mask() & bit) {
+        throw mints::double_alloc("tried double alloc at Node::put, some logical error expected");
     }
-}
 
-Node::~Node() {
-    // cout << ch << " Node with offspring " << offspring_num << " deleted" << endl;
-    for (auto i : next) {
-        if (i != nullptr) {
-            delete i;
-        }
+    // Copy the children into a block one child larger, with the new child at its place.
+    const int size = old.size();
+    const int rank = std::popcount(old.mask() & (bit - 1));
+    ChildSlot* grown = arena.allocate_children(size + 1);
+    grown[0].mask = old.mask() | bit;
+    for (int i = 0; i < rank; ++i) {
+        grown[i + 1].child = old[i];
     }
-    if (to_data != nullptr) {
-        delete to_data;
+    grown[rank + 1].child = arena.allocate(c, level + 1);
+    for (int i = rank; i < size; ++i) {
+        grown[i + 2].child = old[i];
     }
-}
 
-void Node::put(char c) {
-    if (next[c - 97] == nullptr) { // For some make_lowercase char c, (c - 97) converts a to 0, b to 1, ... z to 25
-        next[c - 97] = new Node(c, level + 1);
-        ++offspring_num;
-    } else {
-        throw mints::double_alloc("tried double alloc at Node::put, some logical error expected");
+    // Everything written above is visible to a reader who loads the new block.
+    children.store(grown, std::memory_order_release);
+    if (old_block != nullptr) {
+        arena.retire_children(old_block);
     }
+    ++offspring_num;
 }
 
-void Node::put(const std::string &str) {
-    to_data = new std::string(str);
+void Node::put(uint32_t word_id, uint32_t _weight) {
+    weight.store(_weight, std::memory_order_relaxed);
+    word.store(word_id, std::memory_order_release);
     ++offspring_num;
 }
 
-void Node::remove(char c) {
-    if (next[c - 97] != nullptr) {
-        delete next[c - 97];
-        next[c - 97] = nullptr;
-        --offspring_num;
-    } else {
+void Node::set_weight(uint32_t _weight) {
+    weight.store(_weight, std::memory_order_relaxed);
+}
+
+void Node::raise_max_weight(uint32_t w) {
+    if (w > max_weight.load(std::memory_order_relaxed)) {
+        max_weight.store(w, std::memory_order_relaxed);
+    }
+}
+
+void Node::update_max_weight() {
+    uint32_t m = is_end() ? get_weight() : 0;
+    const Children kids = get_children();
+    for (int i = 0; i < kids.size(); ++i) {
+        m = std::max(m, kids[i]->get_max_weight());
+    }
+    max_weight.store(m, std::memory_order_relaxed);
+}
+
+void Node::put_children(ChildSlot *block, int size) {
+    children.store(block, std::memory_order_release);
+    offspring_num += size;
+}
+
+void Node::remove(int idx, NodeArena& arena) {
+    const ChildMask bit = ChildMask{1} << idx;
+    ChildSlot* old_block = children.load(std::memory_order_relaxed);
+    const Children old(old_block);
+    if (!(old.mask() & bit)) {
         throw mints::double_free("tried double free at Node::remove, some logical error expected");
     }
+
+    const int size = old.size();
+    const int rank = std::popcount(old.mask() & (bit - 1));
+
+    ChildSlot* shrunk = nullptr;
+    if (size > 1) {
+        shrunk = arena.allocate_children(size - 1);
+        shrunk[0].mask = old.mask() & ~bit;
+        for (int i = 0; i < rank; ++i) {
+            shrunk[i + 1].child = old[i];
+        }
+        for (int i = rank + 1; i < size; ++i) {
+            shrunk[i].child = old[i];
+        }
+    }
+
+    children.store(shrunk, std::memory_order_release);
+    arena.retire(old[rank]);
+    arena.retire_children(old_block);
+    --offspring_num;
 }
 
 void Node::remove() {
-    if (to_data != nullptr) {
-        delete to_data;
-        to_data = nullptr;
+    if (word.load(std::memory_order_relaxed) != NO_WORD) {
+        word.store(NO_WORD, std::memory_order_release);
+        weight.store(0, std::memory_order_relaxed);
         --offspring_num;
     } else {
         throw mints::double_free("tried double free at Node::remove, some logical error expected");
     }
 }
 
+void Node::reset(char _c, int _level) {
+    ch = _c;
+    level = _level;
+    offspring_num = 0;
+    children.store(nullptr, std::memory_order_relaxed);
+    word.store(NO_WORD, std::memory_order_relaxed);
+    weight.store(0, std::memory_order_relaxed);
+    max_weight.store(0, std::memory_order_relaxed);
+}
+
 char Node::get_char() const {
     return ch;
 }
 
 Node *Node::get_next(int idx) const {
-    idx -= 97;
-    if (0 <= idx && idx < 26) {
-        return next[idx];
-    }
-    return nullptr;
+    // One load of the block gives a mask and children that belong together.
+    return get_children().find(idx);
 }
 
 int Node::get_level() const {
@@ -72,45 +135,70 @@ int Node::get_offspring_num() const {
     return offspring_num;
 }
 
-std::string *Node::get_strptr() const {
-    return to_data;
+Node::Children Node::get_children() const {
+    return Children(children.load(std::memory_order_acquire));
 }
 
-std::vector<std::string> Node::traverse(const int MAX_VEC_SIZE) const {
-    std::vector<std::string> vecstr;
-    vecstr.reserve(MAX_VEC_SIZE);
+bool Node::is_end() const {
+    return word.load(std::memory_order_acquire) != NO_WORD;
+}
+
+uint32_t Node::get_word() const {
+    return word.load(std::memory_order_acquire);
+}
+
+uint32_t Node::get_weight() const {
+    return weight.load(std::memory_order_relaxed);
+}
+
+uint32_t Node::get_max_weight() const {
+    return max_weight.load(std::memory_order_relaxed);
+}
 
-    // Do Depth-First-Search and get all strings contained at the end node.
-    std::vector<const Node*> stack;
-    stack.push_back(this);
+mints::Generator<std::string_view> Node::words(std::string path) const {
+    // Do Depth-First-Search and yield all strings contained at the end node; the words are spelled out along the path.
+    // Each entry of the stack is (node, length of the path to its parent).
+    std::vector<std::pair<const Node*, std::size_t>> stack;
+    stack.emplace_back(this, path.size());
 
     while (!stack.empty()) {
-        const Node* popped = stack.back();
+        auto [popped, len] = stack.back();
         stack.pop_back();
 
-        if (popped->to_data != nullptr) {
-            vecstr.push_back(*popped->to_data);
-            if (vecstr.size() >= MAX_VEC_SIZE) {
-                break;
-            }
+        path.resize(len);
+        if (popped != this) {
+            path += popped->ch;
         }
 
-        for (int i = 25; i >= 0; --i) {
-            if (popped->next[i] != nullptr) {
-                stack.push_back(popped->next[i]);
-            }
+        // The children go on the stack first, so that nothing of this step is left to do after the yield.
+        const Children popped_children = popped->get_children();
+        for (int i = popped_children.size() - 1; i >= 0; --i) {
+            stack.emplace_back(popped_children[i], path.size());
+        }
+
+        if (popped->is_end()) {
+            co_yield std::string_view(path);
         }
     }
+}
 
+std::vector<std::string> Node::traverse(std::string path, const int MAX_VEC_SIZE) const {
+    std::vector<std::string> vecstr;
+    vecstr.reserve(std::min(MAX_VEC_SIZE, RESERVE_LIMIT));
+    for (std::string_view word : words(std::move(path))) {
+        vecstr.emplace_back(word);
+        if (vecstr.size() >= MAX_VEC_SIZE) {
+            break;
+        }
+    }
     return vecstr;
 }
 
 void Node::depth_first_search(std::string &str) const {
     str += ch;
-    for (auto i : next) {
-        if (i != nullptr) {
-            i->depth_first_search(str);
-        }
+    const Children my_children = get_children();
+    for (int i = 0; i < my_children.size(); ++i) {
+        my_children[i]->depth_first_search(str);
     }
     if (97 <= str.back() && str.back() <= 122) {
         str += '0';
@@ -119,34 +207,288 @@ void Node::depth_first_search(std::string &str) const {
     }
 }
 
-const Node *Trie::deepest_node_so_far(const std::string &str) const {
+void NodeArena::attach(EpochDomain *_epochs) {
+    epochs = _epochs;
+}
+
+Node *NodeArena::allocate(char c, int level) {
+    ++live_nodes;
+    if (!free_nodes.empty()) {
+        Node* node = free_nodes.back();
+        free_nodes.pop_back();
+        node->reset(c, level);
+        return node;
+    }
+
+    if (used_in_last_chunk == CHUNK_SIZE) {
+        chunks.emplace_back(new Chunk);
+        used_in_last_chunk = 0;
+    }
+
+    void* slot = chunks.back()->slots + sizeof(Node) * used_in_last_chunk++;
+    return new (slot) Node(c, level);
+}
+
+void NodeArena::release(Node *node) {
+    std::vector<Node*> stack;
+    stack.push_back(node);
+
+    while (!stack.empty()) {
+        Node* popped = stack.back();
+        stack.pop_back();
+
+        Node::ChildSlot* block = popped->children.load(std::memory_order_relaxed);
+        if (block != nullptr) {
+            const Node::Children popped_children(block);
+            for (int i = 0; i < popped_children.size(); ++i) {
+                stack.push_back(popped_children[i]);
+            }
+            release_children(block);
+        }
+
+        popped->reset(0, 0);
+        free_nodes.push_back(popped);
+        --live_nodes;
+    }
+}
+
+Node::ChildSlot *NodeArena::allocate_children(int size) {
+    if (!free_children[size].empty()) {
+        Node::ChildSlot* block = free_children[size].back();
+        free_children[size].pop_back();
+        return block;
+    }
+
+    // A block never spans two chunks; the tail of a chunk that is too short is just left unused.
+    if (used_in_last_child_chunk + size + 1 > CHILD_CHUNK_SIZE) {
+        child_chunks.emplace_back(new Node::ChildSlot[CHILD_CHUNK_SIZE]);
+        used_in_last_child_chunk = 0;
+    }
+
+    Node::ChildSlot* block = child_chunks.back().get() + used_in_last_child_chunk;
+    used_in_last_child_chunk += size + 1;
+    return block;
+}
+
+void NodeArena::release_children(Node::ChildSlot *block) {
+    free_children[std::popcount(block[0].mask)].push_back(block);
+}
+
+void NodeArena::retire(Node *node) {
+    if (epochs == nullptr) {
+        release(node);
+        return;
+    }
+    retired_nodes.emplace_back(epochs->current(), node);
+    if (retired_nodes.size() + retired_children.size() >= RECLAIM_BATCH) {
+        reclaim();
+    }
+}
+
+void NodeArena::retire_children(Node::ChildSlot *block) {
+    if (epochs == nullptr) {
+        release_children(block);
+        return;
+    }
+    retired_children.emplace_back(epochs->current(), block);
+    if (retired_nodes.size() + retired_children.size() >= RECLAIM_BATCH) {
+        reclaim();
+    }
+}
+
+void NodeArena::reclaim() {
+    if (epochs == nullptr) {
+        return;
+    }
+    const uint64_t oldest = epochs->synchronize();
+
+    // Both lists are in the order of retirement, so the reclaimable ones are at the front.
+    auto node_end = retired_nodes.begin();
+    for (; node_end != retired_nodes.end() && node_end->first < oldest; ++node_end) {
+        release(node_end->second);
+    }
+    retired_nodes.erase(retired_nodes.begin(), node_end);
+
+    auto block_end = retired_children.begin();
+    for (; block_end != retired_children.end() && block_end->first < oldest; ++block_end) {
+        release_children(block_end->second);
+    }
+    retired_children.erase(retired_children.begin(), block_end);
+}
+
+void NodeArena::adopt(NodeArena &other) {
+    if (!other.chunks.empty()) {
+        if (chunks.empty()) {
+            used_in_last_chunk = other.used_in_last_chunk;
+        }
+        chunks.insert(chunks.begin(), std::make_move_iterator(other.chunks.begin()),
+                      std::make_move_iterator(other.chunks.end()));
+    }
+    if (!other.child_chunks.empty()) {
+        if (child_chunks.empty()) {
+            used_in_last_child_chunk = other.used_in_last_child_chunk;
+        }
+        child_chunks.insert(child_chunks.begin(), std::make_move_iterator(other.child_chunks.begin()),
+                            std::make_move_iterator(other.child_chunks.end()));
+    }
+    free_nodes.insert(free_nodes.end(), other.free_nodes.begin(), other.free_nodes.end());
+    for (int size = 0; size <= Node::MAX_CHILDREN; ++size) {
+        free_children[size].insert(free_children[size].end(), other.free_children[size].begin(),
+                                   other.free_children[size].end());
+        other.free_children[size].clear();
+    }
+    live_nodes += other.live_nodes;
+
+    other.chunks.clear();
+    other.child_chunks.clear();
+    other.free_nodes.clear();
+    other.used_in_last_chunk = CHUNK_SIZE;
+    other.used_in_last_child_chunk = CHILD_CHUNK_SIZE;
+    other.live_nodes = 0;
+}
+
+std::size_t NodeArena::chunk_num() const {
+    return chunks.size() + child_chunks.size();
+}
+
+std::size_t NodeArena::node_num() const {
+    return live_nodes;
+}
+
+std::size_t NodeArena::memory_usage() const {
+    return chunks.size() * sizeof(Chunk) + child_chunks.size() * CHILD_CHUNK_SIZE * sizeof(Node::ChildSlot);
+}
+
+template<typename Alphabet, typename Transform>
+BasicTrie<Alphabet, Transform>::BasicTrie(const std::vector<std::string> &vs) : Node(35, 0), word_num(0) {
+    bulk_build(vs.size(), [&vs](std::size_t i) -> const std::string& { return vs[i]; });
+}
+
+template<typename Alphabet, typename Transform>
+BasicTrie<Alphabet, Transform>::BasicTrie(const std::vector<std::string> &vs, unsigned thread_num)
+        : Node(35, 0), word_num(0) {
+    if (thread_num <= 1 || vs.size() < PARALLEL_MIN_WORDS) {
+        bulk_build(vs.size(), [&vs](std::size_t i) -> const std::string& { return vs[i]; });
+        return;
+    }
+
+    // Split the words by their first letter; the empty word belongs to the root itself.
+    std::array<std::vector<uint32_t>, Alphabet::SIZE> parts;
+    bool has_empty_word = false;
+    for (std::size_t i = 0; i < vs.size(); ++i) {
+        if (vs[i].empty()) {
+            has_empty_word = true;
+            continue;
+        }
+        const int idx = Alphabet::index(Transform::at(vs[i], 0));
+        if (idx != -1) {
+            parts[idx].push_back(static_cast<uint32_t>(i));
+        }
+    }
+    if (has_empty_word) {
+        put(word_num++);
+    }
+
+    // Every part numbers its words from its own first id, so that the ids are all different.
+    std::array<uint32_t, Alphabet::SIZE> first_id{};
+    for (int idx = 0; idx < Alphabet::SIZE; ++idx) {
+        first_id[idx] = word_num;
+        word_num += static_cast<uint32_t>(parts[idx].size());
+    }
+
+    std::array<int, Alphabet::SIZE> order{};
+    for (int idx = 0; idx < Alphabet::SIZE; ++idx) {
+        order[idx] = idx;
+    }
+    std::sort(order.begin(), order.end(), [&parts](int lhs, int rhs) {
+        return parts[lhs].size() > parts[rhs].size();
+    });
+
+    std::array<std::unique_ptr<BasicTrie>, Alphabet::SIZE> built;
+    std::atomic<int> next_part{0};
+    auto work = [&]() {
+        for (int n = next_part++; n < Alphabet::SIZE; n = next_part++) {
+            const int idx = order[n];
+            if (parts[idx].empty()) {
+                continue;
+            }
+            auto part = std::make_unique<BasicTrie>();
+            part->word_num = first_id[idx];
+            const std::vector<uint32_t>& ids = parts[idx];
+            part->bulk_build(ids.size(), [&vs, &ids](std::size_t i) -> const std::string& { return vs[ids[i]]; });
+            built[idx] = std::move(part);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const std::size_t worker_num = std::min<std::size_t>(thread_num, Alphabet::SIZE);
+    for (std::size_t i = 1; i < worker_num; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Stitch the parts under the root.
+    ChildMask mask = 0;
+    int size = 0;
+    std::array<Node*, Alphabet::SIZE> kids{};
+    for (int idx = 0; idx < Alphabet::SIZE; ++idx) {
+        if (built[idx] == nullptr) {
+            continue;
+        }
+        ChildSlot* part_root_block = built[idx]->children.load(std::memory_order_relaxed);
+        arena.adopt(built[idx]->arena);
+        if (part_root_block == nullptr) {
+            // Every word of the part had a letter out of the alphabet.
+            continue;
+        }
+        kids[size++] = Children(part_root_block)[0];
+        mask |= ChildMask{1} << idx;
+        arena.release_children(part_root_block);
+    }
+    if (size > 0) {
+        ChildSlot* block = arena.allocate_children(size);
+        block[0].mask = mask;
+        for (int i = 0; i < size; ++i) {
+            block[i + 1].child = kids[i];
+        }
+        put_children(block, size);
+    }
+}
+
+template<typename Alphabet, typename Transform>
+const Node *BasicTrie<Alphabet, Transform>::deepest_node_so_far(std::string_view str) const {
     const Node* travel = this;
-    for (char c : str) {
-        if (travel->get_next(c) == nullptr) {
+    for (std::size_t i = 0; i < str.size(); ++i) {
+        const Node* next = travel->get_next(Alphabet::index(Transform::at(str, i)));
+        if (next == nullptr) {
             return travel;
         }
-        travel = travel->get_next(c);
+        travel = next;
     }
     return travel;
 }
 
-const Node *Trie::if_contained_get_lowest_nonbranch(const std::string &str) const {
+template<typename Alphabet, typename Transform>
+const Node *BasicTrie<Alphabet, Transform>::if_contained_get_lowest_nonbranch(std::string_view str) const {
     // A stack containing all travelled node so far
     std::vector<const Node*> nodes_so_far;
 
     const Node* travel = this;
     nodes_so_far.push_back(travel);
-    for (char c : str) {
-        if (travel->get_next(c) == nullptr) {
+    for (std::size_t i = 0; i < str.size(); ++i) {
+        travel = travel->get_next(Alphabet::index(Transform::at(str, i)));
+        if (travel == nullptr) {
             // If str is not contained in our Trie, then return NULL
             return nullptr;
         }
-        travel = travel->get_next(c);
         nodes_so_far.push_back(travel);
     }
 
-    if (*travel->get_strptr() == str) {
-        while (nodes_so_far.back()->get_offspring_num() == 1) {
+    if (travel->is_end()) {
+        while (!nodes_so_far.empty() && nodes_so_far.back()->get_offspring_num() == 1) {
             nodes_so_far.pop_back();
         }
         if (nodes_so_far.empty()) {
@@ -159,71 +501,302 @@ const Node *Trie::if_contained_get_lowest_nonbranch(const std::string &str) cons
     return nullptr;
 }
 
-bool Trie::_contains_(const std::string &input) const {
-    std::string str = preprocess(input);
-    // Check whether the pushed string does not contain non-make_lowercase-alphabet characters
-    for (char c : str) {
-        if (c < 97 || c > 122) { // 97 == 'a', 122 == 'z'
-            // if a non-make_lowercase-alphabet character is found, then it is not contained in our Trie.
-            return false;
+template<typename Alphabet, typename Transform>
+std::string BasicTrie<Alphabet, Transform>::stored_prefix(std::string_view word, std::size_t length) {
+    std::string prefix;
+    prefix.reserve(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        prefix += Transform::at(word, i);
+    }
+    return prefix;
+}
+
+template<typename Alphabet, typename Transform>
+std::size_t BasicTrie<Alphabet, Transform>::common_prefix_length(std::string_view lhs, std::string_view rhs) {
+    std::size_t len = 0;
+    while (len < lhs.size() && len < rhs.size() && Transform::at(lhs, len) == Transform::at(rhs, len)) {
+        ++len;
+    }
+    return len;
+}
+
+template<typename Alphabet, typename Transform>
+bool BasicTrie<Alphabet, Transform>::comes_before(std::string_view lhs, std::string_view rhs) {
+    const std::size_t shared = common_prefix_length(lhs, rhs);
+    if (shared == rhs.size()) {
+        return false;
+    }
+    return shared == lhs.size() || Alphabet::index(Transform::at(lhs, shared)) < Alphabet::index(Transform::at(rhs, shared));
+}
+
+template<typename Alphabet, typename Transform>
+template<typename WordAt>
+void BasicTrie<Alphabet, Transform>::bulk_build(const std::size_t size, WordAt word_at) {
+    auto can_hold = [](const std::string& str) {
+        return str.size() <= MAX_WORD_LENGTH
+               && std::all_of(str.begin(), str.end(), [](char c) { return Alphabet::index(c) != -1; });
+    };
+
+    // Find the longest run of words in which no word comes before the previous one.
+    std::size_t best_begin = 0, best_end = 0, run_begin = 0;
+    const std::string* previous = nullptr;
+    for (std::size_t i = 0; i < size; ++i) {
+        if (!can_hold(word_at(i))) {
+            continue;
+        }
+        if (previous != nullptr && comes_before(word_at(i), *previous)) {
+            run_begin = i;
+        }
+        previous = &word_at(i);
+        if (i + 1 - run_begin > best_end - best_begin) {
+            best_begin = run_begin;
+            best_end = i + 1;
         }
     }
 
-    // Delete the const feature; now ptr is no more const Node* pointer.
-    Node* ptr = const_cast<Node*>(deepest_node_so_far(str));
+    // A node on the path of the previous word, and the children it has got so far in alphabetical order.
+    struct Open {
+        Node*       node;
+        ChildMask   mask;
+        int         size;
+        std::array<Node*, Alphabet::SIZE> kids;
+    };
+    // path[0, open_num) is the path of the previous word from the root; the slots are reused, not made for every letter.
+    std::vector<Open> path(1);
+    std::size_t open_num = 0;
+    auto open = [&](Node* node) {
+        if (open_num == path.size()) {
+            path.emplace_back();
+        }
+        path[open_num].node = node;
+        path[open_num].mask = 0;
+        path[open_num].size = 0;
+        ++open_num;
+    };
+    // Give every node but the first 'kept' ones of the path its child block, and forget it.
+    auto close = [&](std::size_t kept) {
+        for (; open_num > kept; --open_num) {
+            const Open& last = path[open_num - 1];
+            if (last.size > 0) {
+                ChildSlot* block = arena.allocate_children(last.size);
+                block[0].mask = last.mask;
+                for (int i = 0; i < last.size; ++i) {
+                    block[i + 1].child = last.kids[i];
+                }
+                last.node->put_children(block, last.size);
+            }
+        }
+    };
 
-    if (ptr->get_level() == str.size()) {
-        std::string* temp = ptr->get_strptr();
-        if (temp != nullptr && *temp == str) {
-            // If we found the str in our Trie, then return true.
-            return true;
+    open(this);
+    previous = nullptr;
+    for (std::size_t w = best_begin; w < best_end; ++w) {
+        const std::string& str = word_at(w);
+        if (!can_hold(str)) {
+            continue;
+        }
+
+        const std::size_t shared = previous == nullptr ? 0 : common_prefix_length(*previous, str);
+        if (previous != nullptr && shared == str.size() && shared == previous->size()) {
+            // Same word as the previous one
+            continue;
+        }
+        // The nodes of the first 'shared' letters and the root stay open.
+        close(shared + 1);
+
+        for (std::size_t i = shared; i < str.size(); ++i) {
+            const char c = Transform::at(str, i);
+            Open& parent = path[open_num - 1];
+            Node* child = arena.allocate(c, static_cast<int>(i) + 1);
+            parent.kids[parent.size++] = child;
+            parent.mask |= ChildMask{1} << Alphabet::index(c);
+            open(child);
         }
+        path[open_num - 1].node->put(word_num++);
+
+        previous = &str;
+    }
+    close(0);
+
+    // The words out of the run go in one by one.
+    for (std::size_t w = 0; w < best_begin; ++w) {
+        push(word_at(w));
+    }
+    for (std::size_t w = best_end; w < size; ++w) {
+        push(word_at(w));
+    }
+}
+
+template<typename Alphabet, typename Transform>
+void BasicTrie<Alphabet, Transform>::enable_concurrent_readers() {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    if (epochs == nullptr) {
+        epochs = std::make_unique<EpochDomain>();
+        arena.attach(epochs.get());
+    }
+}
+
+template<typename Alphabet, typename Transform>
+EpochDomain::Guard BasicTrie<Alphabet, Transform>::pin() const {
+    return epochs == nullptr ? EpochDomain::Guard() : epochs->pin();
+}
+
+template<typename Alphabet, typename Transform>
+bool BasicTrie<Alphabet, Transform>::_contains_(const std::string &input) const {
+    const auto guard = pin();
+    // A character out of the alphabet has no child, so the walk stops there and the word is not contained.
+    const Node* ptr = deepest_node_so_far(input);
+
+    if (ptr->get_level() == input.size() && ptr->is_end()) {
+        // If we found the str in our Trie, then return true.
+        return true;
     }
 
     // Otherwise, return false.
     return false;
 }
 
-void Trie::push(const std::string &input) {
-    const std::string str = preprocess(input);
-    // Check whether the pushed string does not contain non-make_lowercase-alphabet characters
-    for (char c : str) {
-        if (c < 97 || c > 122) { // 97 == 'a', 122 == 'z'
-            // if a non-make_lowercase-alphabet character is found, then do nothing
+template<typename Alphabet, typename Transform>
+std::vector<bool> BasicTrie<Alphabet, Transform>::contains_many(std::span<const std::string> inputs) const {
+    const auto guard = pin();
+    std::vector<bool> found(inputs.size(), false);
+
+    /*
+     A lane is one lookup on its way down. Each turn of a lane does one of two steps :
+     1. the node is loaded, so read its child block pointer and prefetch the block;
+     2. the block is loaded, so find the next node and prefetch it.
+     When a lookup is over, the lane takes the next input.
+     */
+    struct Lane {
+        std::string_view str;
+        std::size_t idx = 0, pos = 0;
+        const Node* node = nullptr;
+        Children children{nullptr};
+        bool has_children = false;
+    };
+    std::array<Lane, BATCH_LANES> lanes;
+    std::size_t next_input = 0;
+
+    auto start = [&](Lane& lane) {
+        if (next_input == inputs.size()) {
+            lane.node = nullptr;
             return;
         }
+        lane.idx = next_input++;
+        lane.str = inputs[lane.idx];
+        lane.pos = 0;
+        lane.node = this;
+        lane.has_children = false;
+    };
+
+    int active = 0;
+    for (Lane& lane : lanes) {
+        start(lane);
+        active += lane.node != nullptr;
     }
 
-    // Delete the const feature; now ptr is no more const Node* pointer.
-    Node* ptr = const_cast<Node*>(deepest_node_so_far(str));
+    while (active > 0) {
+        for (Lane& lane : lanes) {
+            if (lane.node == nullptr) {
+                continue;
+            }
 
-    if (ptr->get_level() == str.size()) {
-        std::string* temp = ptr->get_strptr();
-        if (temp != nullptr && *temp == str) {
-            // If str already exists in our Trie, then do nothing.
-            return;
+            if (!lane.has_children) {
+                if (lane.pos == lane.str.size()) {
+                    found[lane.idx] = lane.node->is_end();
+                } else {
+                    lane.children = lane.node->get_children();
+                    lane.children.prefetch();
+                    lane.has_children = true;
+                    continue;
+                }
+            } else {
+                lane.node = lane.children.find(Alphabet::index(Transform::at(lane.str, lane.pos++)));
+                lane.has_children = false;
+                if (lane.node != nullptr) {
+                    __builtin_prefetch(lane.node);
+                    continue;
+                }
+            }
+
+            // This lookup is over; a miss leaves found[idx] false.
+            start(lane);
+            active -= lane.node == nullptr;
         }
     }
 
-    // Input new nodes along the given string.
-    for (int i = ptr->get_level(); i < str.size(); ++i) {
-        ptr->put(str[i]);
-        ptr = ptr->get_next(str[i]);
-    }
+    return found;
+}
 
-    // Input a string at end node, to mark that this is the end node.
-    ptr->put(str);
+template<typename Alphabet, typename Transform>
+std::vector<Node*> BasicTrie<Alphabet, Transform>::path_of(std::string_view word) {
+    std::vector<Node*> path{this};
+    for (std::size_t i = 0; i < word.size(); ++i) {
+        const int idx = Alphabet::index(Transform::at(word, i));
+        Node* next = idx == -1 ? nullptr : path.back()->get_next(idx);
+        if (next == nullptr) {
+            break;
+        }
+        path.push_back(next);
+    }
+    return path;
 }
 
-void Trie::remove(const std::string &str) {
-    // Check whether the pushed string does not contain non-make_lowercase-alphabet characters
-    for (char c : str) {
-        if (c < 97 || c > 122) { // 97 == 'a', 122 == 'z'
-            // if a non-make_lowercase-alphabet character is found, then our Trie may do not contain it: Do nothing.
+template<typename Alphabet, typename Transform>
+void BasicTrie<Alphabet, Transform>::push(const std::string &input, const uint32_t weight) {
+    // A word too long for the level of a node is not put, as a word with characters out of the alphabet.
+    if (input.size() > MAX_WORD_LENGTH) {
+        return;
+    }
+    // Check whether the pushed string does not contain characters out of the alphabet
+    for (char c : input) {
+        if (Alphabet::index(c) == -1) {
+            // if such a character is found, then do nothing
             return;
         }
     }
 
+    // Writers change the Trie one at a time; a writer needs no pin since nothing is recycled under its feet.
+    std::lock_guard<std::mutex> lock(writer_mutex);
+
+    // Delete the const feature; now ptr is no more const Node* pointer.
+    Node* ptr = const_cast<Node*>(deepest_node_so_far(input));
+
+    if (ptr->get_level() == input.size() && ptr->is_end()) {
+        // If str already exists in our Trie, then only its weight may change.
+        if (ptr->get_weight() != weight) {
+            ptr->set_weight(weight);
+            // It may have got lighter, so the max weights on the path are computed again from the bottom.
+            const std::vector<Node*> path = path_of(input);
+            for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                (*it)->update_max_weight();
+            }
+        }
+        return;
+    }
+
+    // Input new nodes along the given string.
+    for (int i = ptr->get_level(); i < input.size(); ++i) {
+        const char c = Transform::at(input, i);
+        const int idx = Alphabet::index(c);
+        ptr->put(idx, c, arena);
+        ptr = ptr->get_next(idx);
+    }
+
+    // The new nodes are all linked, so readers who see the end mark can see the whole path.
+    ptr->put(word_num++, weight);
+    if (weight > 0) {
+        for (Node* node : path_of(input)) {
+            node->raise_max_weight(weight);
+        }
+    }
+}
+
+template<typename Alphabet, typename Transform>
+void BasicTrie<Alphabet, Transform>::remove(const std::string &str) {
+    // A word with characters out of the alphabet is not contained in our Trie: if_contained_get_lowest_nonbranch finds nothing.
+    std::lock_guard<std::mutex> lock(writer_mutex);
+
     // Delete the const feature; now ptr is no more const Node* pointer.
     Node* ptr = const_cast<Node*>(if_contained_get_lowest_nonbranch(str));
 
@@ -237,26 +810,337 @@ void Trie::remove(const std::string &str) {
         ptr->remove();
     } else {
         // If str is contained in our Trie, and there is a branch on our path, then delete the branch
-        ptr->remove(str[ptr->get_level()]);
+        ptr->remove(Alphabet::index(Transform::at(str, ptr->get_level())), arena);
+    }
+
+    // The removed word may have been the heaviest below the nodes left on its path; nothing to do if all weights are 0.
+    if (get_max_weight() > 0) {
+        const std::vector<Node*> path = path_of(str);
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            (*it)->update_max_weight();
+        }
     }
 }
 
-std::vector<std::string> Trie::get_suggestions(const std::string &input, const int MAX_SUGGESTIONS) const {
-    const std::string to_search = preprocess(input);
+template<typename Alphabet, typename Transform>
+std::vector<std::string> BasicTrie<Alphabet, Transform>::get_suggestions(const std::string &input,
+                                                                         const int MAX_SUGGESTIONS) const {
+    const auto guard = pin();
 
     // Find the closest prefix in our dictionary
-    const Node* search_start_node = deepest_node_so_far(to_search);
-    // Load all strings with same prefixes in our dictionary
-    std::vector<std::string> ret = search_start_node->traverse(MAX_SUGGESTIONS);
+    const Node* search_start_node = deepest_node_so_far(input);
+    // Load all strings with same prefixes in our dictionary (See Node::words.)
+    std::vector<std::string> ret = search_start_node->traverse(stored_prefix(input, search_start_node->get_level()),
+                                                               MAX_SUGGESTIONS);
 
     for (auto& i : ret) {
-        i = backprocess(i);
+        Transform::restore(i);
     }
 
     return ret;
 }
 
-std::string Trie::to_txt_data() const {
+template<typename Alphabet, typename Transform>
+mints::Generator<std::string_view> BasicTrie<Alphabet, Transform>::suggestions(std::string input) const {
+    const auto guard = pin();
+
+    // Find the closest prefix in our dictionary
+    const Node* search_start_node = deepest_node_so_far(input);
+    // Yield all strings with same prefixes in our dictionary, turned back into the order of the input in one reused buffer.
+    std::string restored;
+    for (std::string_view word : search_start_node->words(stored_prefix(input, search_start_node->get_level()))) {
+        if constexpr (std::is_same_v<Transform, Identity>) {
+            // Stored as they are read; nothing to turn back
+            co_yield word;
+        } else {
+            restored.assign(word);
+            Transform::restore(restored);
+            co_yield std::string_view(restored);
+        }
+    }
+}
+
+template<typename Alphabet, typename Transform>
+std::vector<std::string> BasicTrie<Alphabet, Transform>::get_top_suggestions(const std::string &input,
+                                                                             const int MAX_SUGGESTIONS) const {
+    const auto guard = pin();
+
+    // Find the closest prefix in our dictionary; the search runs in its subtree.
+    const Node* search_start_node = deepest_node_so_far(input);
+    return heaviest_below(search_start_node, stored_prefix(input, search_start_node->get_level()), MAX_SUGGESTIONS);
+}
+
+template<typename Alphabet, typename Transform>
+std::vector<std::string> BasicTrie<Alphabet, Transform>::heaviest_below(const Node *search_start_node,
+                                                                        const std::string &prefix, const int count) {
+    // Every node met is kept with the entry of its parent, so that a word can be spelled back from its end node.
+    struct Entry {
+        const Node* node;
+        uint32_t    parent;
+    };
+    // In the heap, 'entry' stands for the subtree of its node, or for the word ending there if is_word.
+    struct Candidate {
+        uint32_t    weight;
+        bool        is_word;
+        uint32_t    entry;
+    };
+    std::vector<Entry> entries{{search_start_node, 0}};
+
+    // Whether the path of the entry a comes after that of b in the stored order, a path coming before the longer ones
+    // it starts. Every word of a subtree comes at or after the path of its node, so a word taken out before the
+    // subtrees of the same weight is the first one alphabetically.
+    auto comes_after = [&entries](uint32_t a, uint32_t b) {
+        uint32_t x = a, y = b;
+        while (entries[x].node->get_level() > entries[y].node->get_level()) {
+            x = entries[x].parent;
+        }
+        while (entries[y].node->get_level() > entries[x].node->get_level()) {
+            y = entries[y].parent;
+        }
+        if (x == y) {
+            return entries[a].node->get_level() > entries[b].node->get_level();
+        }
+        while (entries[x].parent != entries[y].parent) {
+            x = entries[x].parent;
+            y = entries[y].parent;
+        }
+        return Alphabet::index(entries[x].node->get_char()) > Alphabet::index(entries[y].node->get_char());
+    };
+    auto lighter = [&comes_after](const Candidate& lhs, const Candidate& rhs) {
+        if (lhs.weight != rhs.weight) {
+            return lhs.weight < rhs.weight;
+        }
+        if (lhs.entry != rhs.entry) {
+            return comes_after(lhs.entry, rhs.entry);
+        }
+        // The subtree of a node before its own word, since the word is only put in the heap when the subtree is opened
+        return lhs.is_word && !rhs.is_word;
+    };
+
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(lighter)> heap(lighter);
+    heap.push({search_start_node->get_max_weight(), false, 0});
+
+    std::vector<std::string> ret;
+    while (!heap.empty() && ret.size() < count) {
+        const Candidate top = heap.top();
+        heap.pop();
+        const Node* node = entries[top.entry].node;
+
+        if (top.is_word) {
+            // Spell the path up to the start node, then put the prefix before it.
+            std::string word;
+            for (uint32_t e = top.entry; e != 0; e = entries[e].parent) {
+                word += entries[e].node->get_char();
+            }
+            word += std::string(prefix.rbegin(), prefix.rend());
+            std::reverse(word.begin(), word.end());
+            Transform::restore(word);
+            ret.push_back(std::move(word));
+            continue;
+        }
+
+        if (node->is_end()) {
+            heap.push({node->get_weight(), true, top.entry});
+        }
+        const Children children = node->get_children();
+        for (int i = 0; i < children.size(); ++i) {
+            entries.push_back({children[i], top.entry});
+            heap.push({children[i]->get_max_weight(), false, static_cast<uint32_t>(entries.size() - 1)});
+        }
+    }
+
+    return ret;
+}
+
+template<typename Alphabet, typename Transform>
+char BasicTrie<Alphabet, Transform>::letter_of(int idx) {
+    static constexpr auto letters = [] {
+        std::array<char, Alphabet::SIZE> ret{};
+        for (int c = 0; c < 256; ++c) {
+            const int i = Alphabet::index(static_cast<char>(c));
+            if (i != -1) {
+                ret[i] = static_cast<char>(c);
+            }
+        }
+        return ret;
+    }();
+    return letters[idx];
+}
+
+template<typename Alphabet, typename Transform>
+mints::Generator<std::string_view> BasicTrie<Alphabet, Transform>::match(const std::string &pattern) const {
+    WildcardPattern compiled(pattern);
+    if constexpr (std::is_same_v<Transform, Reversed>) {
+        return match_stored(compiled.reversed());
+    } else {
+        return match_stored(compiled);
+    }
+}
+
+template<typename Alphabet, typename Transform>
+mints::Generator<std::string_view> BasicTrie<Alphabet, Transform>::match_stored(WildcardPattern pattern) const {
+    const auto guard = pin();
+
+    // Depth-First-Search, spelling the path in one buffer.
+    // Each entry of the stack is a node with the state of the pattern after its path, its level and its letter.
+    struct Frame {
+        const Node*             node;
+        WildcardPattern::State  state;
+        std::size_t             level;
+        char                    c;
+    };
+    std::vector<Frame> stack{{this, pattern.start(), 0, 0}};
+    std::string path, restored;
+
+    while (!stack.empty()) {
+        const Frame frame = stack.back();
+        stack.pop_back();
+
+        if (frame.level > 0) {
+            path.resize(frame.level - 1);
+            path += frame.c;
+        }
+
+        // The letters of the children come from the mask, so a child the pattern cannot take is never loaded.
+        // They are pushed from the last letter, so that they come out alphabetically; and before the yield,
+        // so that nothing of this step is left to do after it.
+        const Children children = frame.node->get_children();
+        for (ChildMask rest = children.mask(); rest != 0; ) {
+            const int idx = 63 - std::countl_zero(rest);
+            rest &= ~(ChildMask{1} << idx);
+            const char c = letter_of(idx);
+            const WildcardPattern::State next = pattern.step(frame.state, c);
+            if (next != 0) {
+                stack.push_back({children[std::popcount(rest)], next, frame.level + 1, c});
+            }
+        }
+
+        if (pattern.is_match(frame.state) && frame.node->is_end()) {
+            if constexpr (!std::is_same_v<Transform, Identity>) {
+                restored.assign(path);
+                Transform::restore(restored);
+            }
+            const std::string_view word = std::is_same_v<Transform, Identity> ? path : restored;
+            co_yield word;
+        }
+    }
+}
+
+template<typename Alphabet, typename Transform>
+std::vector<std::string> BasicTrie<Alphabet, Transform>::get_matches(const std::string &pattern,
+                                                                     const int MAX_MATCHES) const {
+    std::vector<std::string> ret;
+    for (std::string_view word : match(pattern)) {
+        if (ret.size() >= MAX_MATCHES) {
+            break;
+        }
+        ret.emplace_back(word);
+    }
+    return ret;
+}
+
+template<typename Alphabet, typename Transform>
+void BasicTrie<Alphabet, Transform>::Cursor::advance(char c) {
+    // Still in the Trie only if every letter so far was
+    if (path.size() == typed.size() + 1) {
+        const int idx = Alphabet::index(c);
+        const Node* next = idx == -1 ? nullptr : path.back()->get_next(idx);
+        if (next != nullptr) {
+            path.push_back(next);
+        }
+    }
+    typed += c;
+}
+
+template<typename Alphabet, typename Transform>
+void BasicTrie<Alphabet, Transform>::Cursor::backspace() {
+    if (typed.empty()) {
+        return;
+    }
+    if (path.size() == typed.size() + 1) {
+        path.pop_back();
+    }
+    typed.pop_back();
+}
+
+template<typename Alphabet, typename Transform>
+void BasicTrie<Alphabet, Transform>::Cursor::reset() {
+    path.resize(1);
+    typed.clear();
+}
+
+template<typename Alphabet, typename Transform>
+bool BasicTrie<Alphabet, Transform>::Cursor::is_word() const {
+    return is_prefix() && path.back()->is_end();
+}
+
+template<typename Alphabet, typename Transform>
+bool BasicTrie<Alphabet, Transform>::Cursor::is_prefix() const {
+    return path.size() == typed.size() + 1;
+}
+
+template<typename Alphabet, typename Transform>
+const std::string &BasicTrie<Alphabet, Transform>::Cursor::get_typed() const {
+    return typed;
+}
+
+template<typename Alphabet, typename Transform>
+std::vector<std::string> BasicTrie<Alphabet, Transform>::Cursor::completions(const int count) const {
+    if (!is_prefix()) {
+        return {};
+    }
+    const auto guard = trie->pin();
+    // Without weights every word weighs 0, so the best-first search would only give them alphabetically, as a walk does.
+    if (trie->get_max_weight() == 0) {
+        std::vector<std::string> ret = path.back()->traverse(typed, count);
+        for (auto& word : ret) {
+            Transform::restore(word);
+        }
+        return ret;
+    }
+    return heaviest_below(path.back(), typed, count);
+}
+
+template<typename Alphabet, typename Transform>
+typename BasicTrie<Alphabet, Transform>::Cursor BasicTrie<Alphabet, Transform>::cursor() const {
+    return Cursor(*this);
+}
+
+template<typename Alphabet, typename Transform>
+std::vector<std::string> BasicTrie<Alphabet, Transform>::traverse(const int MAX_VEC_SIZE) const {
+    const auto guard = pin();
+    return Node::traverse("", MAX_VEC_SIZE);
+}
+
+template<typename Alphabet, typename Transform>
+std::vector<std::string> BasicTrie<Alphabet, Transform>::get_suggestions_within(const std::string &input,
+                                                                                const int max_distance,
+                                                                                const int MAX_SUGGESTIONS) const {
+    const auto guard = pin();
+    std::vector<std::string> ret;
+    for (auto& [word, distance] : mints::search_within_distance(*this, Transform()(input), max_distance)) {
+        if (ret.size() >= MAX_SUGGESTIONS) {
+            break;
+        }
+        Transform::restore(word);
+        ret.push_back(std::move(word));
+    }
+    return ret;
+}
+
+template<typename Alphabet, typename Transform>
+const Node *BasicTrie<Alphabet, Transform>::root_state() const {
+    return this;
+}
+
+template<typename Alphabet, typename Transform>
+bool BasicTrie<Alphabet, Transform>::is_end_state(const Node *state) const {
+    return state->is_end();
+}
+
+template<typename Alphabet, typename Transform>
+std::string BasicTrie<Alphabet, Transform>::to_txt_data() const requires std::is_same_v<Alphabet, Ascii26> {
+    const auto guard = pin();
     std::string txt_holder;
 
     depth_first_search(txt_holder);
@@ -264,10 +1148,33 @@ std::string Trie::to_txt_data() const {
     return txt_holder;
 }
 
-auto Trie::get_preprocess() const {
-    return preprocess;
+template<typename Alphabet, typename Transform>
+std::size_t BasicTrie<Alphabet, Transform>::node_num() const {
+    // The root is the Trie itself, not a node of the arena.
+    return arena.node_num() + 1;
 }
 
-auto Trie::get_backprocess() const {
-    return backprocess;
+template<typename Alphabet, typename Transform>
+std::size_t BasicTrie<Alphabet, Transform>::memory_usage() const {
+    return sizeof(BasicTrie) + arena.memory_usage();
 }
+
+template<typename Alphabet, typename Transform>
+FrozenTrie BasicTrie<Alphabet, Transform>::freeze() const requires std::is_same_v<Alphabet, Ascii26> {
+    const auto guard = pin();
+    return FrozenTrie(*this, Transform(), Transform());
+}
+
+template<typename Alphabet, typename Transform>
+Transform BasicTrie<Alphabet, Transform>::get_preprocess() const {
+    return Transform();
+}
+
+template<typename Alphabet, typename Transform>
+Transform BasicTrie<Alphabet, Transform>::get_backprocess() const {
+    return Transform();
+}
+
+template class BasicTrie<Ascii26, Identity>;
+template class BasicTrie<Ascii26, Reversed>;
+template class BasicTrie<HangulAscii, Identity>;
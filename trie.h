@@ -4,73 +4,302 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <type_traits>
 #include <utility>
 
 #include "mint_utils.h"
+#include "epoch.h"
+#include "generator.h"
+#include "wildcard.h"
+
+class NodeArena;
+class FrozenTrie;
+
+/*
+ An 'alphabet' policy tells which letters a Trie can hold : index(c) numbers the letters from 0 to SIZE - 1,
+ and returns -1 for any other character, which a Trie then treats as 'not in the dictionary'.
+ A node keeps its children in a 64-bit mask, so SIZE is at most Node::MAX_CHILDREN.
+ */
+struct Ascii26 {
+    static constexpr int SIZE = 26;
+    static constexpr int index(char c) { return 97 <= c && c <= 122 ? c - 97 : -1; }  // 97 == 'a', 122 == 'z'
+};
+
+/*
+ A 'transform' policy tells in which order a Trie stores the letters of a word.
+ at(word, i) is the i-th letter in that order, so a lookup walks the word as it is, without making a transformed copy.
+ operator() makes the transformed copy where one is really needed (as the preprocess of a FrozenTrie, or for a suggestion search),
+ and restore() turns a stored word back into the word in place.
+ */
+struct Identity {
+    static constexpr char at(std::string_view word, std::size_t i) { return word[i]; }
+    static void restore(std::string&) {}
+    std::string operator()(std::string_view word) const { return std::string(word); }
+};
+
+// Words are stored from the last letter, so the words sharing a suffix share a path.
+struct Reversed {
+    static constexpr char at(std::string_view word, std::size_t i) { return word[word.size() - 1 - i]; }
+    static void restore(std::string& stored) { std::reverse(stored.begin(), stored.end()); }
+    std::string operator()(std::string_view word) const { return {word.rbegin(), word.rend()}; }
+};
 
 class Node {
+    /*
+     A node does not keep a slot for each of the 26 alphabets, since most nodes of a dictionary have only one or two children.
+     Instead, the children live in a packed 'child block' holding only the existing children in alphabetical order,
+     after a child mask whose bit i tells whether the child for the i-th letter of the alphabet exists.
+     The child for the i-th letter is found at block[1 + popcount(mask & ((1 << i) - 1))].
+     i.e. if a node has children 'b', 'e' and 'x' (letter 1, 4 and 23 of Ascii26), then
+        block == {...00100000000000000000010010 (bit 1, 4, 23), b, e, x}
+     and get_next(23) counts 2 set bits below bit 23, so it returns block[1 + 2].
+     A node does not know the alphabet; the Trie turns characters into letter numbers before asking.
+
+     The mask and the children are kept in the same block so that a node changes its children with a single pointer store:
+     a writer builds a new block next to the old one and swaps the pointer, and a reader running at the same time
+     sees either the old children or the new ones, but never a half-made block (See Trie::enable_concurrent_readers.)
+
+     An end node does not keep its word either. The word of an end node is exactly the path from the root,
+     so traversals spell the words out while they walk down; the node keeps only the id of its word.
+
+     A word may have a weight, such as how often it is used (0 if none is given). Besides the weight of its own word,
+     a node keeps the largest weight of any word at or below it, so that a search for the heaviest words can go
+     down the most promising subtree first and leave the others alone (See BasicTrie::get_top_suggestions.)
+     */
+public:
+    static constexpr uint32_t NO_WORD = UINT32_MAX;
+    /*
+     The mask shares slot 0 of a child block with a child pointer, so it has 64 bits for free :
+     an alphabet may have up to 64 letters with no bigger node or block (See HangulAscii.)
+     */
+    using ChildMask = uint64_t;
+    static constexpr int MAX_CHILDREN = 64;
+    // The level of a node is kept in 16 bits, so a Trie holds no word longer than this; longer ones are skipped like
+    // words with characters out of the alphabet.
+    static constexpr std::size_t MAX_WORD_LENGTH = UINT16_MAX;
+    // Traversals reserve room for at most this many words up front; a bigger MAX_VEC_SIZE grows as the words come.
+    static constexpr int RESERVE_LIMIT = 1 << 16;
+
+    // Slot 0 of a child block is the mask, and the children follow it.
+    union ChildSlot {
+        ChildMask   mask;
+        Node*       child;
+    };
+
+    // The children of a node as they were at one moment; it stays valid while the reader is pinned.
+    class Children {
+        const ChildSlot* block;
+    public:
+        explicit Children(const ChildSlot* _block) : block(_block) {}
+        [[nodiscard]] ChildMask mask() const { return block == nullptr ? 0 : block[0].mask; }
+        [[nodiscard]] int size() const { return std::popcount(mask()); }
+        // n-th existing child in alphabetical order, 0 <= n < size()
+        [[nodiscard]] Node* operator[](int n) const { return block[n + 1].child; }
+        // The child for the letter number 'idx', or nullptr if there is none.
+        [[nodiscard]] Node* find(int idx) const {
+            if (idx < 0 || MAX_CHILDREN <= idx || !(mask() >> idx & 1u)) {
+                return nullptr;
+            }
+            return block[1 + std::popcount(block[0].mask & ((ChildMask{1} << idx) - 1))].child;
+        }
+        // Ask the CPU to start loading the block, for a batch of lookups that comes back to it later.
+        void prefetch() const { __builtin_prefetch(block); }
+    };
+
 protected:
+    std::atomic<ChildSlot*> children;
+    std::atomic<uint32_t> word;  // Id of the word ending here, or NO_WORD if this is not an end node.
+    std::atomic<uint32_t> weight;       // Weight of the word ending here
+    std::atomic<uint32_t> max_weight;   // The largest weight of the words at or below this node
+    uint16_t level;
+    uint8_t offspring_num;
     char ch;
-    int level, offspring_num;
-    std::array<Node*, 26> next{};
-    std::string* to_data;
 
 public:
     Node(char _c, int _level);
-    virtual ~Node();
 
     Node(const Node&) = delete;
     Node(const Node&&) = delete;
     Node& operator=(const Node&) = delete;
 
-    // Add some nodes
-    void put(char c);
-    // Add a string at end node : The node with non-NULL string* to_data means that it is the end node.
-    void put(const std::string& str);
+    // Add the child 'c', the letter number 'idx' : every new node and child block is taken from the arena owned by the Trie.
+    void put(int idx, char c, NodeArena& arena);
+    // Mark this node as an end node of the word with the given id and weight.
+    void put(uint32_t word_id, uint32_t _weight = 0);
+    // Give the word ending here a new weight; the max weights above are left to the caller.
+    void set_weight(uint32_t _weight);
+    // max_weight = max(max_weight, w) : a word of weight w was put at or below this node.
+    void raise_max_weight(uint32_t w);
+    // Compute max_weight again from the own weight and the children, after a word below got lighter or was removed.
+    void update_max_weight();
+    // Give a node with no children all of its children at once : 'block' is filled in, and its mask has 'size' bits set.
+    void put_children(ChildSlot* block, int size);
 
-    void remove(char c);
+    // Removing a child hands its whole subtree back to the arena.
+    void remove(int idx, NodeArena& arena);
     void remove();
 
+    // Turn a node back into a blank node as if it were just constructed.
+    void reset(char _c, int _level);
+
     // Get functions
     [[nodiscard]] char get_char() const;
     [[nodiscard]] Node* get_next(int idx) const;
     [[nodiscard]] int get_level() const;
     [[nodiscard]] int get_offspring_num() const;
-    [[nodiscard]] std::string* get_strptr() const;
+    [[nodiscard]] Children get_children() const;
+    [[nodiscard]] bool is_end() const;
+    [[nodiscard]] uint32_t get_word() const;
+    [[nodiscard]] uint32_t get_weight() const;
+    [[nodiscard]] uint32_t get_max_weight() const;
     // Get functions end
 
-    // Traversal function
-    [[nodiscard]] std::vector<std::string> traverse(int MAX_VEC_SIZE) const;
+    /*
+     The words at and below this node in alphabetical order, found lazily by Depth-First-Search.
+     'path' is the word spelled by the path from the root to this node. Every yielded view points into one buffer
+     that the search keeps rewriting, so nothing is allocated per word; a view is valid until the search goes on.
+     */
+    [[nodiscard]] mints::Generator<std::string_view> words(std::string path) const;
+
+    // Traversal function : the first MAX_VEC_SIZE of words(path), copied.
+    [[nodiscard]] std::vector<std::string> traverse(std::string path, int MAX_VEC_SIZE) const;
 
     // Depth-First-Search method.
 protected:
     void depth_first_search(std::string& str) const;
+
+    friend class NodeArena;
 };
 
-class Trie : Node {
+class NodeArena {
+    /*
+     "NodeArena" owns every node of a Trie except the root, and every child block of the nodes.
+     Nodes are carved out of big chunks one after another (a bump allocation), so a Trie with 100k nodes costs
+     only a few dozens of heap allocations, and the nodes made in a row sit next to each other in memory.
+     Child blocks are carved out of their own chunks in the same way, and they are recycled by their size:
+     when a node grows from 2 children to 3, its old block of 2 children is kept for the next node that needs 2.
+     Nodes given back by Trie::remove are kept on a free list and handed out again before touching a new chunk.
+     All chunks are freed at once when the arena dies; there is no recursive teardown of the nodes,
+     and not even a destructor call since a node owns nothing.
+
+     When readers may run at the same time as the writer, a node or block taken out of the Trie is not recycled at once,
+     since a reader may still be looking at it. It is 'retired' instead, and recycled once no reader can reach it (See epoch.h.)
+     */
+    static constexpr int CHUNK_SIZE = 1024;
+    static constexpr int CHILD_CHUNK_SIZE = 8192;
+    // Retired things are reclaimed in batches, so that the writer does not look at every reader on every change.
+    static constexpr int RECLAIM_BATCH = 64;
+
+    struct Chunk {
+        alignas(Node) unsigned char slots[sizeof(Node) * CHUNK_SIZE];
+    };
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    int used_in_last_chunk;
+    std::vector<Node*> free_nodes;
+    // Nodes handed out and not given back yet
+    std::size_t live_nodes;
+
+    std::vector<std::unique_ptr<Node::ChildSlot[]>> child_chunks;
+    int used_in_last_child_chunk;
+    // free_children[n] keeps the released child blocks of n children.
+    std::array<std::vector<Node::ChildSlot*>, Node::MAX_CHILDREN + 1> free_children;
+
+    // nullptr unless readers may run at the same time as the writer
+    EpochDomain* epochs;
+    // (epoch of retirement, subtree or child block) waiting for the readers who may see them
+    std::vector<std::pair<uint64_t, Node*>> retired_nodes;
+    std::vector<std::pair<uint64_t, Node::ChildSlot*>> retired_children;
+
+public:
+    NodeArena() : used_in_last_chunk(CHUNK_SIZE), live_nodes(0), used_in_last_child_chunk(CHILD_CHUNK_SIZE), epochs(nullptr) {}
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    // From now on, retire() and retire_children() wait for the readers of the given domain.
+    void attach(EpochDomain* _epochs);
+
+    [[nodiscard]] Node* allocate(char c, int level);
+    // Give back the node and all of its offsprings.
+    void release(Node* node);
+
+    // A block for 'size' children; the caller fills in the mask and the children.
+    [[nodiscard]] Node::ChildSlot* allocate_children(int size);
+    void release_children(Node::ChildSlot* block);
+
+    // Same as release() and release_children(), but after every reader who may see the node or the block is gone.
+    void retire(Node* node);
+    void retire_children(Node::ChildSlot* block);
+    // Recycle what was retired before the oldest pinned reader.
+    void reclaim();
+
+    /*
+     Take over every chunk of 'other', which is left empty; its nodes and blocks stay where they are, and now belong to us.
+     Its chunks go before ours, so that we go on allocating from our own last chunks; the unused tails of its last chunks
+     are lost, which is at most one chunk of each kind. 'other' must have nothing retired.
+     */
+    void adopt(NodeArena& other);
+
+    [[nodiscard]] std::size_t chunk_num() const;
+    // Nodes handed out and not given back yet, including the retired ones waiting for readers.
+    [[nodiscard]] std::size_t node_num() const;
+    // Bytes taken by all chunks, including the free slots.
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+template<typename Alphabet, typename Transform>
+class BasicTrie : Node {
     /*
      "Trie" class is used to implement a powerful data structure called "Trie" : Check the description of "Node" class.
      "Trie" class inherits "Node" class, and it has no additional data but has some useful methods:
      We did this due to obey the Data-hiding rule. We want to apply these methods only at the root node of "Trie".
      If not, we will get a garbage value.
+
+     Which letters the Trie holds and in which order it stores them are fixed by the two policies above,
+     so a lookup makes no indirect call and no copy of the word.
+     The usual two are the aliases Trie (Ascii26, Identity) and ReversedTrie (Ascii26, Reversed), defined below.
      */
-    std::function<std::string(std::string)> preprocess, backprocess;
+    static_assert(Alphabet::SIZE <= MAX_CHILDREN, "a node holds at most MAX_CHILDREN children");
+
+    NodeArena arena;
+    // Ids handed out to the words so far. Ids of removed words are not reused.
+    uint32_t word_num;
+    // Writers take turns; readers never take it.
+    std::mutex writer_mutex;
+    // nullptr unless enable_concurrent_readers() was called
+    std::unique_ptr<EpochDomain> epochs;
+
+    // The number of lookups contains_many keeps in flight
+    static constexpr int BATCH_LANES = 16;
+    // Below this many words, starting the threads costs more than they save.
+    static constexpr std::size_t PARALLEL_MIN_WORDS = 1 << 16;
 public:
-    explicit Trie(std::function<std::string(std::string)> f, std::function<std::string(std::string)> g)
-            : Node(35, 0), preprocess(std::move(f)), backprocess(std::move(g)) {}
+    BasicTrie() : Node(35, 0), word_num(0) {}
             // Character number 35 means "#"; Initializes the top node
-    explicit Trie(const std::vector<std::string>& vs,
-         std::function<std::string(std::string)> f, std::function<std::string(std::string)> g)
-            : Node(35, 0), preprocess(std::move(f)), backprocess(std::move(g)) {
-        for (const auto& str : vs) {
-            push(str);
-        }
-    }
+    // Words sorted in the stored order, as dict.txt mostly is for Trie, are put in one pass (See bulk_build.)
+    explicit BasicTrie(const std::vector<std::string>& vs);
+    /*
+     Same as above, but with up to 'thread_num' threads. The subtrees under the letters of the root share no node,
+     so the words are split by their first letter in the stored order (the last letter of the word for ReversedTrie),
+     and each part is built as above by a worker thread, in a Trie and an arena of its own.
+     The root then takes the top node of every part as its child, and our arena adopts the arenas of the parts.
+     The parts are handed out from the biggest one, so that no thread is left with a big part at the end.
+     Small inputs (See PARALLEL_MIN_WORDS) and thread_num <= 1 are built by the calling thread alone.
+     */
+    BasicTrie(const std::vector<std::string>& vs, unsigned thread_num);
 
-    Trie(const Trie&) = delete;
-    Trie(const Trie&&) = delete;
-    Trie& operator=(const Trie&) = delete;
+    BasicTrie(const BasicTrie&) = delete;
+    BasicTrie(const BasicTrie&&) = delete;
+    BasicTrie& operator=(const BasicTrie&) = delete;
 
 private:
     /*
@@ -87,7 +316,7 @@ private:
      deepest_node_so_far(rt) returns r at Lv.1;
      deepest_node_so_far(tr) returns # at Lv.0.
      */
-    [[nodiscard]] const Node* deepest_node_so_far(const std::string& str) const;
+    [[nodiscard]] const Node* deepest_node_so_far(std::string_view str) const;
 
     /*
      if_contained_get_lowest_nonbranch(str) returns the lowest nonbranch node on the way to 'str' node if 'str' is in our Tree, otherwise return NULL.
@@ -103,12 +332,74 @@ private:
      if_contained_get_lowest_nonbranch(st) returns # at Lv.0;
      if_contained_get_lowest_nonbranch(sg) returns NULL.
      */
-    [[nodiscard]] const Node* if_contained_get_lowest_nonbranch(const std::string& str) const;
+    [[nodiscard]] const Node* if_contained_get_lowest_nonbranch(std::string_view str) const;
+
+    // The first 'length' letters of 'word' in the stored order
+    [[nodiscard]] static std::string stored_prefix(std::string_view word, std::size_t length);
+
+    // The number of leading letters two words share in the stored order
+    [[nodiscard]] static std::size_t common_prefix_length(std::string_view lhs, std::string_view rhs);
+    // Whether 'lhs' comes strictly before 'rhs' in the stored order, comparing letters by their numbers in the alphabet
+    [[nodiscard]] static bool comes_before(std::string_view lhs, std::string_view rhs);
+
+    /*
+     Build an empty Trie from the words, in one pass and with no walk from the root, as far as they are sorted.
+     For words sorted in the stored order, the next word shares its first letters with the previous one only, so the nodes
+     of the previous word below their longest common prefix will never get another child. We keep the nodes of the previous
+     word on a stack, with the children each has got so far; when a word comes, the nodes below the common prefix are popped,
+     and each of them gets its whole child block at once, allocated once at its exact size.
+     The nodes themselves are taken from the arena in the order of the words, so a word's path lies together in memory.
+     Only the longest sorted run of the input is built this way, and the words out of it are pushed afterwards;
+     so any input works, and a sorted list with a few words out of place, like dict.txt, is built almost all in one pass.
+     The ids of the words follow the order in which they are put, so the words out of the run get the last ids.
+     The input is the words word_at(0), ..., word_at(size - 1).
+     */
+    template<typename WordAt>
+    void bulk_build(std::size_t size, WordAt word_at);
+
+    // The nodes on the path of 'word' from the root, as far as they exist; the root is the first one.
+    [[nodiscard]] std::vector<Node*> path_of(std::string_view word);
+
+    // The heaviest 'count' words at and below 'start', whose path from the root is 'prefix' (See get_top_suggestions.)
+    [[nodiscard]] static std::vector<std::string> heaviest_below(const Node* start, const std::string& prefix, int count);
+
+    // The letter of the index 'idx' in the alphabet : the inverse of Alphabet::index
+    [[nodiscard]] static char letter_of(int idx);
+    // The search behind match(), with the pattern already in the stored order
+    [[nodiscard]] mints::Generator<std::string_view> match_stored(WildcardPattern pattern) const;
 
 public:
 
+    /*
+     After this call, any number of threads may look up the Trie (_contains_, get_suggestions, get_suggestions_within,
+     traverse, ...) while other threads push and remove words. Lookups never lock and never wait for a writer;
+     writers take turns among themselves, and swap in their changes one child block at a time (See Node.)
+     A lookup sees every word whose push finished before it started, and may or may not see the ones being pushed meanwhile.
+     Call it before the Trie is shared; a Trie used by one thread only does not need it and does not pay for it.
+     */
+    void enable_concurrent_readers();
+
+    // Hold the returned guard while walking the Trie by hand (root_state, for_each_child, ...) in the concurrent mode.
+    // The lookups below take one by themselves.
+    [[nodiscard]] EpochDomain::Guard pin() const;
+
     [[nodiscard]] bool _contains_(const std::string& input) const;
-    void push(const std::string& input);
+
+    /*
+     contains_many(inputs)[i] == _contains_(inputs[i]), but much faster for a big batch.
+     A lookup waits for a cache miss at every level, to load the next node and its child block.
+     Here BATCH_LANES lookups go down together, one level each in turn, and each of them asks the CPU to load
+     what it needs for the next level before handing over to the next one; by the time it comes back, the data is there.
+     So the memory waits of the lookups overlap instead of adding up.
+     */
+    [[nodiscard]] std::vector<bool> contains_many(std::span<const std::string> inputs) const;
+
+    /*
+     Put a word with an optional weight. Pushing a word already in the Trie gives it the new weight.
+     The nodes on its path raise their max weights on the way, so a weight costs nothing more than one walk down.
+     */
+    void push(const std::string& input, uint32_t weight = 0);
+    // The max weights of the nodes left on the path are computed again, from the bottom up.
     void remove(const std::string& str);
 
     /*
@@ -119,13 +410,111 @@ public:
      */
     [[nodiscard]] std::vector<std::string> get_suggestions(const std::string& input, int MAX_SUGGESTIONS) const;
 
-    // to_txt_data
-    [[nodiscard]] std::string to_txt_data() const;
+    /*
+     Same words as get_suggestions, in the same order, but one at a time and with no copies : the caller may stop
+     whenever it has enough, or skip words as they come. A view is valid until the generator goes on (See Node::words.)
+     The Trie stays pinned while the generator lives, so drop it when done in the concurrent mode.
+     */
+    [[nodiscard]] mints::Generator<std::string_view> suggestions(std::string input) const;
+
+    /*
+     The heaviest MAX_SUGGESTIONS words among the words get_suggestions chooses from, heaviest first.
+     The search is best-first : a heap holds the subtrees met so far by their max weights and the words by their weights,
+     and the top is taken out each time; a subtree taken out puts its own word and its children in the heap.
+     A word comes out only when no subtree left in the heap can hold a heavier word, so the first words out are
+     the answer, and the search touches about MAX_SUGGESTIONS paths and their siblings however big the subtree is.
+     Among equal weights, the words come alphabetically in the stored order, as Lexicon::get_top_suggestions gives them.
+     */
+    [[nodiscard]] std::vector<std::string> get_top_suggestions(const std::string& input, int MAX_SUGGESTIONS) const;
+
+    /*
+     The words matching a wildcard pattern like "cro?sw*d" or "[bc]at*" (See wildcard.h), alphabetically in the stored order,
+     one at a time as the caller reads them. The search goes down only along the letters the pattern can still take :
+     a child is not even loaded when no word through it can match, so a pattern starting with letters costs
+     about as much as a prefix lookup plus the matches. A pattern starting with '*' may match below any node,
+     so it walks the whole Trie; for one with a fixed ending like "*tion", ReversedTrie::match only walks under that ending.
+     Throws mints::invalid_pattern right away for a malformed pattern. Views are valid until the generator goes on.
+     */
+    [[nodiscard]] mints::Generator<std::string_view> match(const std::string& pattern) const;
+    // The first MAX_MATCHES words of match(pattern), copied
+    [[nodiscard]] std::vector<std::string> get_matches(const std::string& pattern, int MAX_MATCHES) const;
+
+    /*
+     "Cursor" follows a word while it is typed, one letter at a time, for as-you-type completion.
+     It keeps the path of nodes to the letters typed so far, so a new letter is one step down from the last node
+     and a backspace is one step up; no keystroke walks from the root again, however long the word gets.
+     Letters are given in the stored order of the Trie. When the typed letters leave the Trie, the cursor only counts
+     them, so that backspacing over them comes back to the last node.
+     The Trie must outlive the cursor, and no word may be removed while it lives, since it keeps pointers to the nodes.
+     */
+    class Cursor {
+        const BasicTrie*            trie;
+        std::vector<const Node*>    path;       // The root and the nodes of the typed letters, as far as they are in the Trie
+        std::string                 typed;
+
+    public:
+        explicit Cursor(const BasicTrie& _trie) : trie(&_trie), path{&_trie} {}
+
+        void advance(char c);
+        void backspace();
+        // Forget every typed letter, for the next word.
+        void reset();
+
+        // Whether the typed letters are a word of the Trie
+        [[nodiscard]] bool is_word() const;
+        // Whether some word starts with the typed letters
+        [[nodiscard]] bool is_prefix() const;
+        [[nodiscard]] const std::string& get_typed() const;
+        /*
+         At most 'count' words starting with the typed letters : the heaviest first if the Trie has weights,
+         and otherwise in alphabetical order. Empty if no word starts with them.
+         */
+        [[nodiscard]] std::vector<std::string> completions(int count) const;
+    };
+
+    // A cursor at the root, with nothing typed
+    [[nodiscard]] Cursor cursor() const;
 
-    // getter functions
-    [[nodiscard]] auto get_preprocess() const;
-    [[nodiscard]] auto get_backprocess() const;
+    // At most MAX_VEC_SIZE words of the Trie, as they are stored, in alphabetical order.
+    [[nodiscard]] std::vector<std::string> traverse(int MAX_VEC_SIZE) const;
+
+    /*
+     Suggestions by edit distance : returns the words within 'max_distance' edits of the input, the closest first.
+     Unlike get_suggestions, this also finds the words whose first letters differ from the input (See edit_distance.h.)
+     */
+    [[nodiscard]] std::vector<std::string> get_suggestions_within(const std::string& input, int max_distance,
+                                                                  int MAX_SUGGESTIONS) const;
+
+    // Walking functions used by the search algorithms : a 'state' of a Trie is just a node.
+    [[nodiscard]] const Node* root_state() const;
+    [[nodiscard]] bool is_end_state(const Node* state) const;
+    template<typename F>
+    void for_each_child(const Node* state, F&& f) const {
+        const Children children = state->get_children();
+        for (int i = 0; i < children.size(); ++i) {
+            f(children[i]->get_char(), static_cast<const Node*>(children[i]));
+        }
+    }
+
+    // to_txt_data : the text spells the letters out as 'a' to 'z', so only an Ascii26 Trie has one.
+    [[nodiscard]] std::string to_txt_data() const requires std::is_same_v<Alphabet, Ascii26>;
+
+    // The number of nodes, including the root
+    [[nodiscard]] std::size_t node_num() const;
+    // Bytes taken by the nodes and the child blocks.
+    [[nodiscard]] std::size_t memory_usage() const;
+
+    // Compile this Trie into a read-only double-array trie, with the transform as its preprocess and backprocess (See frozen_trie.h.)
+    // A FrozenTrie takes the letters 'a' to 'z' only.
+    [[nodiscard]] FrozenTrie freeze() const requires std::is_same_v<Alphabet, Ascii26>;
+
+    // getter functions : the transform works both ways, since both policies are their own inverse.
+    [[nodiscard]] Transform get_preprocess() const;
+    [[nodiscard]] Transform get_backprocess() const;
 };
 
+using Trie = BasicTrie<Ascii26, Identity>;
+using ReversedTrie = BasicTrie<Ascii26, Reversed>;
+
 
 #endif //OOPFINAL_TRIE_H
@@ -0,0 +1,112 @@
+#include "wildcard.h"
+#include "mint_utils.h"
+
+#include <string>
+
+WildcardPattern::WildcardPattern(std::string_view pattern) {
+    auto too_long = [&pattern]() {
+        return mints::invalid_pattern("Too many tokens in the pattern : {pattern : " + std::string(pattern) + "}");
+    };
+
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+        if (c == '*') {
+            if (token_num == 0 || !(stars >> (token_num - 1) & 1u)) {
+                if (token_num == MAX_TOKENS) {
+                    throw too_long();
+                }
+                stars |= uint64_t{1} << token_num++;
+            }
+            continue;
+        }
+        if (token_num == MAX_TOKENS) {
+            throw too_long();
+        }
+        const uint64_t bit = uint64_t{1} << token_num++;
+
+        if (c == '?') {
+            for (auto& accept : accepts) {
+                accept |= bit;
+            }
+        } else if (c == '[') {
+            // A class : the letters up to the closing ']', which may come first to stand for itself.
+            std::size_t j = i + 1;
+            const bool negated = j < pattern.size() && (pattern[j] == '^' || pattern[j] == '!');
+            if (negated) {
+                ++j;
+            }
+            std::array<bool, 256> in_class{};
+            const std::size_t first = j;
+            for (; j < pattern.size() && (pattern[j] != ']' || j == first); ++j) {
+                auto from = static_cast<unsigned char>(pattern[j]);
+                auto to = from;
+                if (j + 2 < pattern.size() && pattern[j + 1] == '-' && pattern[j + 2] != ']') {
+                    to = static_cast<unsigned char>(pattern[j + 2]);
+                    j += 2;
+                }
+                for (int letter = from; letter <= to; ++letter) {
+                    in_class[letter] = true;
+                }
+            }
+            if (j == pattern.size()) {
+                throw mints::invalid_pattern("Unclosed '[' in the pattern : {pattern : " + std::string(pattern) + "}");
+            }
+            for (int letter = 0; letter < 256; ++letter) {
+                if (in_class[letter] != negated) {
+                    accepts[letter] |= bit;
+                }
+            }
+            i = j;
+        } else {
+            accepts[static_cast<unsigned char>(c)] |= bit;
+        }
+    }
+}
+
+WildcardPattern WildcardPattern::reversed() const {
+    // The token i becomes the token token_num - 1 - i.
+    auto mirror = [this](uint64_t bits) {
+        uint64_t ret = 0;
+        for (int i = 0; i < token_num; ++i) {
+            if (bits >> i & 1u) {
+                ret |= uint64_t{1} << (token_num - 1 - i);
+            }
+        }
+        return ret;
+    };
+    WildcardPattern ret;
+    ret.token_num = token_num;
+    ret.stars = mirror(stars);
+    for (int letter = 0; letter < 256; ++letter) {
+        ret.accepts[letter] = mirror(accepts[letter]);
+    }
+    return ret;
+}
+
+uint64_t WildcardPattern::closure(uint64_t state) const {
+    // No '*' is followed by another, so one skip is enough.
+    return state | (state & stars) << 1;
+}
+
+WildcardPattern::State WildcardPattern::start() const {
+    return closure(1);
+}
+
+WildcardPattern::State WildcardPattern::step(State state, char c) const {
+    return closure((state & accepts[static_cast<unsigned char>(c)]) << 1 | (state & stars));
+}
+
+bool WildcardPattern::is_match(State state) const {
+    return state >> token_num & 1u;
+}
+
+bool WildcardPattern::matches(std::string_view word) const {
+    State state = start();
+    for (char c : word) {
+        state = step(state, c);
+        if (state == 0) {
+            return false;
+        }
+    }
+    return is_match(state);
+}
@@ -0,0 +1,53 @@
+#ifndef OOPFINAL_WILDCARD_H
+#define OOPFINAL_WILDCARD_H
+
+#include <array>
+#include <string_view>
+#include <cstdint>
+
+class WildcardPattern {
+    /*
+     "WildcardPattern" is a compiled pattern for dictionary searches like "cro?sw*d" :
+        ?           any one letter
+        *           any run of letters, even an empty one
+        [abc]       one of the letters a, b and c; [a-f] is a range, and [^abc] (or [!abc]) any letter but those
+        others      the letter itself
+     The pattern is a row of tokens, and it is run as a set of positions in that row at once, rather than by
+     backtracking, so that no pattern takes exponential time : bit i of a 'state' is set if the letters read so far
+     may have matched the first i tokens. Reading a letter moves each position past a token taking that letter,
+     and keeps it on a '*'; a position in front of a '*' may also skip it. The word matches if the state has bit
+     token_num, i.e. every token is matched. A state of 0 means that no word starting with the letters read can match,
+     which is what lets a trie search leave a whole subtree alone.
+     With a table of the tokens taking each letter, reading a letter is a few operations on one 64-bit word.
+     */
+    static constexpr int MAX_TOKENS = 63;
+
+    // accepts[c] has bit i set if the token i is not a '*' and takes the letter c.
+    std::array<uint64_t, 256> accepts{};
+    // Bit i is set if the token i is a '*'. No two '*' are next to each other; "**" is kept as one.
+    uint64_t stars = 0;
+    int token_num = 0;
+
+    WildcardPattern() = default;
+
+    // The positions reachable from 'state' by skipping '*'s
+    [[nodiscard]] uint64_t closure(uint64_t state) const;
+
+public:
+    using State = uint64_t;
+
+    // Throws mints::invalid_pattern for an unclosed '[' or more than MAX_TOKENS tokens.
+    explicit WildcardPattern(std::string_view pattern);
+
+    // The same pattern read from the last letter, for a dictionary storing its words reversed
+    [[nodiscard]] WildcardPattern reversed() const;
+
+    [[nodiscard]] State start() const;
+    // The state after reading 'c' in 'state'; 0 if no word going on this way can match.
+    [[nodiscard]] State step(State state, char c) const;
+    [[nodiscard]] bool is_match(State state) const;
+
+    [[nodiscard]] bool matches(std::string_view word) const;
+};
+
+#endif //OOPFINAL_WILDCARD_H